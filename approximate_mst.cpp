@@ -0,0 +1,89 @@
+#include "approximate_mst.hpp"
+#include "radix_kruskal.hpp"
+#include "spanning_forest.hpp"
+#include "union_find.hpp"
+#include "graph.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+namespace {
+
+//more classes than this fall back to the exact forest (the class table would outgrow the edges)
+constexpr std::size_t MAX_CLASSES = std::size_t {1} << 24;
+
+ApproximateForest exactForest(const Graph& G) {
+    ApproximateForest result;
+    result.forest = radixKruskalForest(G);
+    result.lowerBound = result.forest.weight;
+    return result;
+}
+
+}  // namespace
+
+ApproximateForest approximateMST(const Graph& G, double epsilon) {
+    if (epsilon <= 0) return exactForest(G);
+    Index n = G.numVertices();
+    std::vector<Graph::Edge> edges;
+    for (Index u = 0; u < n; ++u) {
+        for (const auto& e : *G.neighbours(u)) {
+            if (u == e.v1 && e.v1 != e.v2) edges.push_back(e);     //avoid duplicate edge and self-loops
+        }
+    }
+    double smallest = 0;                            //smallest positive weight
+    for (const auto& e : edges) {
+        if (e.weight > 0 && (smallest == 0 || e.weight < smallest)) smallest = static_cast<double>(e.weight);
+    }
+
+    //class 0: weights <= 0, class c >= 1: [smallest (1 + epsilon)^(c - 1), smallest (1 + epsilon)^c)
+    double logBase = std::log1p(epsilon);
+    std::vector<std::uint32_t> weightClass(edges.size());
+    std::size_t numClasses = 1;
+    for (std::size_t i = 0; i < edges.size(); ++i) {
+        if (edges[i].weight <= 0) {
+            weightClass[i] = 0;
+            continue;
+        }
+        double c = std::floor(std::log(static_cast<double>(edges[i].weight) / smallest) / logBase) + 1;
+        if (!(c < static_cast<double>(MAX_CLASSES))) return exactForest(G);
+        weightClass[i] = static_cast<std::uint32_t>(c);
+        numClasses = std::max<std::size_t>(numClasses, weightClass[i] + 1);
+    }
+
+    //bucket the edges by class with one counting pass
+    std::vector<std::size_t> start(numClasses + 1, 0);
+    for (auto c : weightClass) ++start[c + 1];
+    for (std::size_t c = 0; c < numClasses; ++c) start[c + 1] += start[c];
+    std::vector<Graph::Edge> bucketed(edges.size());
+    {
+        std::vector<std::size_t> next(start.begin(), start.end() - 1);
+        for (std::size_t i = 0; i < edges.size(); ++i) bucketed[next[weightClass[i]]++] = edges[i];
+    }
+    edges = std::vector<Graph::Edge>();
+    std::sort(bucketed.begin(), bucketed.begin() + start[1], lighterEdge);   //non-positive weights
+
+    ApproximateForest result;
+    result.forest = SpanningForest(n);
+    result.forest.edges.reserve(n > 0 ? n - 1 : 0);
+    UnionFind UF(n);
+    for (std::size_t c = 0; c < numClasses && static_cast<Index>(result.forest.edges.size()) < n - 1; ++c) {
+        double lowerEnd = (c == 0) ? 0 : smallest * std::pow(1 + epsilon, static_cast<double>(c - 1));
+        for (std::size_t i = start[c]; i < start[c + 1]; ++i) {
+            const auto& e = bucketed[i];
+            Index root1 = UF.find(e.v1);
+            Index root2 = UF.find(e.v2);
+            if (root1 == root2) continue;
+            UF.merge(root1, root2);
+            result.forest.add(e);
+            result.lowerBound += (c == 0) ? e.weight : std::min(static_cast<double>(e.weight), lowerEnd);
+        }
+    }
+    result.numClasses = numClasses;
+    WeightSum weight = result.forest.weight;
+    if (weight == result.lowerBound) result.errorBound = 0;
+    else if (result.lowerBound > 0) result.errorBound = static_cast<double>(weight) / result.lowerBound - 1;
+    else result.errorBound = std::numeric_limits<double>::infinity();   //no ratio around a total <= 0
+    return result;
+}
@@ -0,0 +1,28 @@
+#ifndef APPROXIMATE_MST_HPP_
+#define APPROXIMATE_MST_HPP_
+
+#include "graph.hpp"
+#include "spanning_forest.hpp"
+#include <cstddef>
+
+//result of approximateMST with its certificate
+struct ApproximateForest {
+    SpanningForest forest;
+    WeightSum lowerBound {0};       //certified lower bound on the minimum spanning forest weight
+    double errorBound {0};          //forest.weight <= (1 + errorBound) * optimum, at most epsilon
+    std::size_t numClasses {0};     //weight classes used
+};
+
+//(1 + epsilon)-approximate minimum spanning forest without sorting the edges
+//positive weights fall into geometric classes [w0 (1 + epsilon)^(c - 1), w0 (1 + epsilon)^c)
+//(w0: smallest positive weight), non-positive weights into one class that is sorted exactly.
+//one counting pass buckets the edges, Kruskal takes the classes in order and the edges of a
+//class in any order, stopping after n - 1 edges.
+//the forest is a minimum spanning forest for the lower class ends, so the sum of those over its
+//edges is a lower bound on the optimum: errorBound = weight / lowerBound - 1 is what was
+//achieved (<= epsilon for non-negative weights, usually well below; infinity if negative
+//weights push lowerBound to <= 0 while the forest is heavier).
+//epsilon <= 0, or a weight range needing too many classes, gives the exact forest (radix Kruskal)
+ApproximateForest approximateMST(const Graph& G, double epsilon);
+
+#endif      // APPROXIMATE_MST_HPP_
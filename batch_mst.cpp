@@ -0,0 +1,154 @@
+#include "batch_mst.hpp"
+#include "union_find.hpp"
+#include "graph.hpp"
+#include "thread_pool.hpp"
+#include <algorithm>
+#include <atomic>
+#include <vector>
+
+namespace {
+
+//graphs a thread takes at once from the shared counter
+constexpr std::size_t GRAPHS_PER_CHUNK = 64;
+
+//buffers of one thread, sized by the largest graph seen so far
+struct Scratch {
+    UnionFind UF {0};
+    std::vector<Index> order;       //Kruskal: usable edge positions by weight
+    std::vector<Index> best;        //Prim: lightest edge between every vertex pair, -1 if none
+    std::vector<Index> via;         //Prim: lightest edge from the tree to every vertex
+    std::vector<char> inTree;       //Prim: vertex already in a tree
+};
+
+//edge order within one graph: weight, then position
+bool lighter(const Graph::Edge* e, Index a, Index b) {
+    if (e[a].weight != e[b].weight) return e[a].weight < e[b].weight;
+    return a < b;
+}
+
+bool usable(const Graph::Edge& e, Index n) {
+    return e.v1 >= 0 && e.v2 >= 0 && e.v1 < n && e.v2 < n && e.v1 != e.v2;
+}
+
+//Kruskal, stops once the forest is a spanning tree
+//writes the chosen positions to out and returns how many there are
+Index kruskal(Index n, const Graph::Edge* e, Index m, Scratch& s, Index* out, WeightSum& weight) {
+    s.order.clear();
+    for (Index i = 0; i < m; ++i) {
+        if (usable(e[i], n)) s.order.push_back(i);
+    }
+    std::sort(s.order.begin(), s.order.end(), [e](Index a, Index b) { return lighter(e, a, b); });
+    s.UF.reset(n);
+    Index count = 0;
+    for (Index i : s.order) {
+        if (count == n - 1) break;
+        Index root1 = s.UF.find(e[i].v1);
+        Index root2 = s.UF.find(e[i].v2);
+        if (root1 == root2) continue;
+        s.UF.merge(root1, root2);
+        out[count++] = i;
+        weight += e[i].weight;
+    }
+    return count;
+}
+
+//Prim on an n x n matrix of lightest parallel edges, O(n^2 + m), one tree after another
+Index densePrim(Index n, const Graph::Edge* e, Index m, Scratch& s, Index* out, WeightSum& weight) {
+    s.best.assign(static_cast<std::size_t>(n) * n, -1);
+    for (Index i = 0; i < m; ++i) {
+        if (!usable(e[i], n)) continue;
+        Index& slot = s.best[static_cast<std::size_t>(e[i].v1) * n + e[i].v2];
+        if (slot == -1 || lighter(e, i, slot)) {
+            slot = i;
+            s.best[static_cast<std::size_t>(e[i].v2) * n + e[i].v1] = i;
+        }
+    }
+    s.via.assign(n, -1);
+    s.inTree.assign(n, 0);
+    Index count = 0;
+    for (Index start = 0; start < n; ++start) {
+        if (s.inTree[start]) continue;
+        Index u = start;
+        while (u != -1) {
+            s.inTree[u] = 1;
+            if (s.via[u] != -1) {
+                out[count++] = s.via[u];
+                weight += e[s.via[u]].weight;
+            }
+            //relax the edges of u and pick the closest vertex outside the tree
+            const Index* row = s.best.data() + static_cast<std::size_t>(u) * n;
+            Index next = -1;
+            for (Index v = 0; v < n; ++v) {
+                if (s.inTree[v]) continue;
+                if (row[v] != -1 && (s.via[v] == -1 || lighter(e, row[v], s.via[v]))) s.via[v] = row[v];
+                if (s.via[v] != -1 && (next == -1 || lighter(e, s.via[v], s.via[next]))) next = v;
+            }
+            u = next;
+        }
+    }
+    return count;
+}
+
+}  // namespace
+
+void GraphBatch::add(Index n, const std::vector<Graph::Edge>& graphEdges) {
+    numVertices.push_back(n);
+    edges.insert(edges.end(), graphEdges.begin(), graphEdges.end());
+    edgeOffset.push_back(edges.size());
+}
+
+void GraphBatch::add(const Graph& G) {
+    numVertices.push_back(G.numVertices());
+    for (Index u = 0; u < G.numVertices(); ++u) {
+        for (const auto& e : *G.neighbours(u)) {
+            if (u == e.v1 && e.v1 != e.v2) edges.push_back(e);      //avoid duplicate edge
+        }
+    }
+    edgeOffset.push_back(edges.size());
+}
+
+BatchForests batchMST(const GraphBatch& batch, int numThreads) {
+    std::size_t numGraphs = batch.numGraphs();
+    BatchForests result;
+    result.weight.assign(numGraphs, 0);
+    result.offset.assign(numGraphs + 1, 0);
+    if (numGraphs == 0) return result;
+
+    //room for n - 1 edges per graph, compacted once all are done
+    std::vector<std::size_t> slot(numGraphs + 1, 0);
+    for (std::size_t g = 0; g < numGraphs; ++g) {
+        slot[g + 1] = slot[g] + static_cast<std::size_t>(std::max<Index>(batch.numVertices[g] - 1, 0));
+    }
+    std::vector<Index> chosen(slot[numGraphs]);
+    std::vector<Index> count(numGraphs, 0);
+
+    std::size_t numChunks = (numGraphs + GRAPHS_PER_CHUNK - 1) / GRAPHS_PER_CHUNK;
+    ThreadPool& pool = globalThreadPool();
+    if (numThreads <= 0) numThreads = pool.numThreads();
+    numThreads = static_cast<int>(std::min<std::size_t>(numThreads, numChunks));
+    std::atomic<std::size_t> nextGraph {0};
+    auto worker = [&](int) {
+        Scratch s;
+        std::size_t begin;
+        while ((begin = nextGraph.fetch_add(GRAPHS_PER_CHUNK)) < numGraphs) {
+            std::size_t end = std::min(numGraphs, begin + GRAPHS_PER_CHUNK);
+            for (std::size_t g = begin; g < end; ++g) {
+                Index n = batch.numVertices[g];
+                const Graph::Edge* e = batch.edges.data() + batch.edgeOffset[g];
+                auto m = static_cast<Index>(batch.edgeOffset[g + 1] - batch.edgeOffset[g]);
+                Index* out = chosen.data() + slot[g];
+                count[g] = (n <= DENSE_PRIM_MAX_VERTICES) ? densePrim(n, e, m, s, out, result.weight[g])
+                                                          : kruskal(n, e, m, s, out, result.weight[g]);
+            }
+        }
+    };
+    pool.parallelParts(numThreads, worker);
+
+    for (std::size_t g = 0; g < numGraphs; ++g) result.offset[g + 1] = result.offset[g] + count[g];
+    result.edges.resize(result.offset[numGraphs]);
+    for (std::size_t g = 0; g < numGraphs; ++g) {
+        std::copy(chosen.begin() + slot[g], chosen.begin() + slot[g] + count[g],
+                  result.edges.begin() + result.offset[g]);
+    }
+    return result;
+}
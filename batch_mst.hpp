@@ -0,0 +1,49 @@
+#ifndef BATCH_MST_HPP_
+#define BATCH_MST_HPP_
+
+#include "graph.hpp"
+#include <vector>
+#include <cstddef>
+
+//Many small graphs packed into one flat buffer
+//graph g has numVertices[g] vertices and the edges edges[edgeOffset[g] .. edgeOffset[g + 1]),
+//with endpoints local to the graph (0 .. numVertices[g] - 1); edge IDs are ignored,
+//an edge is identified by its position in its graph's slice
+struct GraphBatch {
+    std::vector<Index> numVertices;
+    std::vector<std::size_t> edgeOffset {0};
+    std::vector<Graph::Edge> edges;
+
+    //append a graph with n vertices
+    void add(Index n, const std::vector<Graph::Edge>& graphEdges);
+    //append G, its edges in adjacency order (each once, without self-loops)
+    void add(const Graph& G);
+    std::size_t numGraphs() const {
+        return numVertices.size();
+    }
+};
+
+//minimum spanning forests of a batch, packed the same way
+//the forest of graph g is edges[offset[g] .. offset[g + 1]), positions in g's edge slice
+//in the order they were chosen; weight[g] is its total weight
+struct BatchForests {
+    std::vector<std::size_t> offset {0};
+    std::vector<Index> edges;
+    std::vector<WeightSum> weight;
+
+    std::size_t numGraphs() const {
+        return weight.size();
+    }
+};
+
+//graphs with at most this many vertices use dense Prim, larger ones Kruskal
+constexpr Index DENSE_PRIM_MAX_VERTICES = 48;
+
+//minimum spanning forest of every graph in the batch
+//ties are broken by position in the graph's slice, so the forest is unique and the same for
+//both kernels (and equal to boruvkaMST on Graph(n, slice), whose edge IDs are the positions).
+//numThreads workers (tasks on globalThreadPool(), <= 0: one per pool thread) each reuse one set
+//of scratch buffers for all their graphs, graphs are handed out in small chunks
+BatchForests batchMST(const GraphBatch& batch, int numThreads = 0);
+
+#endif      // BATCH_MST_HPP_
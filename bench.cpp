@@ -0,0 +1,510 @@
+#include <iostream>
+#include <vector>
+#include <string>
+#include <random>
+#include <chrono>
+#include <cmath>
+#include <algorithm>
+#include <functional>
+#include <utility>
+#include "graph.hpp"
+#include "boruvka.hpp"
+#include "kkt.hpp"
+#include "dynamic_mst.hpp"
+#include "euclidean_mst.hpp"
+#include "boruvka_kernel.hpp"
+#include "reorder.hpp"
+#include "mst_cache.hpp"
+#include "memory_tracker.hpp"
+#include "sensitivity.hpp"
+#include "bottleneck.hpp"
+#include "lca.hpp"
+#include "spanning_forest.hpp"
+#include "batch_mst.hpp"
+#include "radix_kruskal.hpp"
+#include "numa_mst.hpp"
+#include "approximate_mst.hpp"
+#include "compressed_graph.hpp"
+#include "partitioned_mst.hpp"
+#include "thread_pool.hpp"
+#include "boruvka_hierarchy.hpp"
+#include "union_find.hpp"
+#include <array>
+#include <atomic>
+#include <numeric>
+#include <thread>
+#include <cstdio>
+
+//Benchmarks for the mst library
+//usage: mst_bench [name ...]   (no names: run all)
+
+//----------helpers---------
+
+Graph randomEuclideanGraph(int N, int numEdges, unsigned seed) {
+  std::mt19937 mt {seed};
+  std::uniform_int_distribution<int> pointDist {0, N};
+  std::vector<std::pair<int, int> > points(N);
+  std::generate(points.begin(), points.end(),
+      [&mt, &pointDist](){return std::pair {pointDist(mt), pointDist(mt)};});
+  Graph G {N};
+  std::uniform_int_distribution<int> indexDist {0, N - 1};
+  for (int i = 0; i < numEdges; ++i) {
+    int index1 = indexDist(mt);
+    int index2 = indexDist(mt);
+    double dx = points.at(index1).first - points.at(index2).first;
+    double dy = points.at(index1).second - points.at(index2).second;
+    G.addEdge({static_cast<Weight>(std::sqrt(dx * dx + dy * dy)), index1, index2});
+  }
+  return G;
+}
+
+// run f once and return elapsed milliseconds
+template <typename F>
+double timeMs(F&& f) {
+  auto start = std::chrono::steady_clock::now();
+  f();
+  auto stop = std::chrono::steady_clock::now();
+  return std::chrono::duration<double, std::milli>(stop - start).count();
+}
+
+void report(const std::string& name, double ms) {
+  std::cout << "  " << name << ": " << ms << " ms\n";
+}
+
+//----------benchmarks---------
+
+// stream of random updates applied to DynamicMST vs recomputing with kktMST
+void benchDynamicMST() {
+  const int N = 2'000;
+  const int numEdges = 10'000;
+  const int numUpdates = 2'000;
+  Graph G = randomEuclideanGraph(N, numEdges, 91'823);
+  DynamicMST dyn(G);
+  std::mt19937 mt {5'511};
+  std::uniform_int_distribution<int> vertexDist {0, N - 1};
+  std::uniform_int_distribution<int> idDist {0, numEdges - 1};
+  std::uniform_real_distribution<double> weightDist {0.0, static_cast<double>(N)};
+  std::uniform_int_distribution<int> opDist {0, 2};
+  double ms = timeMs([&] {
+    for (int i = 0; i < numUpdates; ++i) {
+      switch (opDist(mt)) {
+        case 0: dyn.insertEdge(vertexDist(mt), vertexDist(mt), weightDist(mt)); break;
+        case 1: dyn.deleteEdge(idDist(mt)); break;
+        default: dyn.updateWeight(idDist(mt), weightDist(mt)); break;
+      }
+    }
+  });
+  std::cout << "dynamic MST (n=" << N << ", m=" << numEdges << ", "
+            << numUpdates << " updates)\n";
+  report("DynamicMST per update", ms / numUpdates);
+  Graph current = dyn.graph();
+  report("kktMST recompute", timeMs([&] { kktMST(current); }));
+  report("boruvkaMST recompute", timeMs([&] { boruvkaMST(current); }));
+}
+
+// Euclidean MST straight from points vs Boruvka on a random edge sample of the same size
+void benchEuclideanMST() {
+  const int N = 200'000;
+  std::mt19937 mt {4'321};
+  std::uniform_real_distribution<double> coordDist {0.0, 1.0};
+  std::vector<std::array<double, 2> > points(N);
+  for (auto& p : points) p = {coordDist(mt), coordDist(mt)};
+  std::cout << "Euclidean MST (n=" << N << " points)\n";
+  report("euclideanMST 1 thread", timeMs([&] { euclideanMST(points, 1); }));
+  report("euclideanMST all threads", timeMs([&] { euclideanMST(points); }));
+  Graph G = randomEuclideanGraph(N, 10 * N, 4'321);
+  report("boruvkaMST on 10n random edges", timeMs([&] { boruvkaMST(G); }));
+}
+
+// Boruvka hierarchy export vs the MST alone and vs rebuilding the levels with boruvkaStep
+void benchHierarchy() {
+  const int N = 500'000;
+  const int numEdges = 4'000'000;
+  Graph G = randomEuclideanGraph(N, numEdges, 4'949);
+  std::cout << "Boruvka hierarchy (n=" << N << ", m=" << numEdges << ")\n";
+  report("boruvkaSpanningForest", timeMs([&] { boruvkaSpanningForest(G); }));
+  BoruvkaHierarchy H;
+  report("boruvkaHierarchy", timeMs([&] { H = boruvkaHierarchy(G); }));
+  std::cout << "  rounds: " << H.numRounds() << ", " << H.memoryBytes() / (1 << 20) << " MiB\n";
+  report("boruvkaStep until no edges", timeMs([&] {
+    Graph level = G;
+    for (;;) {
+      auto [chosen, contracted] = boruvkaStep(level);
+      if (chosen.empty()) break;
+      level = std::move(contracted);
+    }
+  }));
+}
+
+// boruvkaMST with each Boruvka scan kernel
+void benchBoruvkaKernels() {
+  const int N = 100'000;
+  const int numEdges = 2'500'000;
+  Graph G = randomEuclideanGraph(N, numEdges, 223'238);
+  std::cout << "Boruvka scan kernels (n=" << N << ", m=" << numEdges << ")\n";
+  BoruvkaKernel original = boruvkaKernel();
+  for (auto [kernel, name] : {std::pair {BoruvkaKernel::Scalar, "scalar"},
+                              std::pair {BoruvkaKernel::AVX2, "avx2"},
+                              std::pair {BoruvkaKernel::AVX512, "avx512"}}) {
+    if (setBoruvkaKernel(kernel) != kernel) continue;     //not supported here
+    report(std::string("boruvkaMST ") + name, timeMs([&] { boruvkaMST(G); }));
+  }
+  setBoruvkaKernel(original);
+}
+
+// MST engines on a grid graph with scrambled vertex IDs, with and without reordering first
+void benchReorder() {
+  const int side = 700;
+  const int N = side * side;
+  std::mt19937 mt {808};
+  std::vector<int> label(N);
+  std::iota(label.begin(), label.end(), 0);
+  std::shuffle(label.begin(), label.end(), mt);
+  std::uniform_real_distribution<double> weightDist {0.0, 1.0};
+  std::vector<std::array<double, 2> > coords(N);
+  Graph G {N};
+  for (int x = 0; x < side; ++x) {
+    for (int y = 0; y < side; ++y) {
+      int v = label[x * side + y];
+      coords[v] = {1.0 * x, 1.0 * y};
+      if (x > 0) G.addEdge({static_cast<Weight>(weightDist(mt)), label[(x - 1) * side + y], v});
+      if (y > 0) G.addEdge({static_cast<Weight>(weightDist(mt)), label[x * side + y - 1], v});
+    }
+  }
+  std::cout << "vertex reordering (" << side << " x " << side << " grid, shuffled IDs)\n";
+  report("boruvkaMST shuffled", timeMs([&] { boruvkaMST(G); }));
+  report("kktMST shuffled", timeMs([&] { kktMST(G); }));
+  for (auto [order, name] : {std::pair {VertexOrder::BFS, "BFS"},
+                             std::pair {VertexOrder::RCM, "RCM"},
+                             std::pair {VertexOrder::Hilbert, "Hilbert"}}) {
+    ReorderedGraph R;
+    double prep = timeMs([&] {
+      R = (order == VertexOrder::Hilbert) ? reorderGraph(G, coords) : reorderGraph(G, order);
+    });
+    report(std::string(name) + " reordering", prep);
+    report(std::string("boruvkaMST ") + name, timeMs([&] { boruvkaMST(R.graph); }));
+    report(std::string("kktMST ") + name, timeMs([&] { kktMST(R.graph); }));
+  }
+}
+
+// minimax query throughput: BottleneckOracle vs binary lifting LCA
+void benchBottleneck() {
+  const int N = 1'000'000;
+  const int numEdges = 4'000'000;
+  const int numQueries = 4'000'000;
+  Graph G = randomEuclideanGraph(N, numEdges, 4'040);
+  Graph mst = boruvkaMST(G);
+  std::cout << "bottleneck queries (n=" << N << ", m=" << numEdges << ", " << numQueries << " queries)\n";
+  std::mt19937 mt {4'041};
+  std::uniform_int_distribution<int> indexDist {0, N - 1};
+  std::vector<std::pair<int, int> > queries(numQueries);
+  for (auto& q : queries) q = {indexDist(mt), indexDist(mt)};
+  auto throughput = [numQueries](const std::string& name, double ms) {
+    std::cout << "  " << name << ": " << ms << " ms (" << numQueries / ms / 1'000 << " M queries/s)\n";
+  };
+
+  LCA lca;
+  report("LCA build", timeMs([&] { lca = LCA(mst); }));
+  BottleneckOracle oracle;
+  report("BottleneckOracle build", timeMs([&] { oracle = BottleneckOracle(mst); }));
+  std::cout << "  oracle size: " << oracle.memoryBytes() / (1 << 20) << " MiB, LCA size: "
+            << lca.memoryBytes() / (1 << 20) << " MiB\n";
+  double sum = 0;
+  throughput("LCA::maxEdgeWeight", timeMs([&] {
+    for (auto [u, v] : queries) sum += lca.maxEdgeWeight(u, v);
+  }));
+  throughput("BottleneckOracle 1 thread", timeMs([&] {
+    for (auto [u, v] : queries) sum += oracle.bottleneck(u, v);
+  }));
+  int numThreads = static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+  std::vector<double> partial(numThreads, 0);
+  throughput("BottleneckOracle " + std::to_string(numThreads) + " threads", timeMs([&] {
+    std::vector<std::thread> threads;
+    for (int t = 0; t < numThreads; ++t) {
+      threads.emplace_back([&, t] {
+        double local = 0;
+        for (std::size_t i = t; i < queries.size(); i += numThreads) {
+          local += oracle.bottleneck(queries[i].first, queries[i].second);
+        }
+        partial[t] = local;
+      });
+    }
+    for (auto& th : threads) th.join();
+  }));
+  std::string file = "bottleneck_bench.bin";
+  report("save", timeMs([&] { oracle.save(file); }));
+  report("load", timeMs([&] { oracle.load(file); }));
+  std::remove(file.c_str());
+  if (sum < 0) std::cout << sum;                 //keep the queries alive
+}
+
+// (1 + epsilon)-approximate forest vs the exact engines
+void benchApproximate() {
+  const int N = 500'000;
+  const int numEdges = 4'000'000;
+  Graph G = randomEuclideanGraph(N, numEdges, 4'646);
+  std::cout << "approximate MST (n=" << N << ", m=" << numEdges << ")\n";
+  WeightSum optimum = 0;
+  report("boruvkaSpanningForest", timeMs([&] { optimum = boruvkaSpanningForest(G).weight; }));
+  report("radixKruskalForest", timeMs([&] { radixKruskalForest(G); }));
+  for (double epsilon : {0.1, 0.01}) {
+    ApproximateForest A;
+    report("approximateMST epsilon=" + std::to_string(epsilon), timeMs([&] { A = approximateMST(G, epsilon); }));
+    std::cout << "    classes: " << A.numClasses << ", certified error: " << A.errorBound
+              << ", actual error: " << A.forest.weight / optimum - 1 << "\n";
+  }
+  report("kktMST", timeMs([&] { kktMST(G); }));
+}
+
+// footprint of CompressedGraph per weight encoding and its engines, next to Boruvka on the Graph
+void benchCompressed() {
+  //road-like: a grid with a third of its edges missing, in BFS order
+  const int side = 1'000;
+  std::mt19937 mt {1'717};
+  std::uniform_real_distribution<double> weightDist {1.0, 1000.0};
+  std::bernoulli_distribution keep {0.65};
+  Graph grid {side * side};
+  for (int x = 0; x < side; ++x) {
+    for (int y = 0; y < side; ++y) {
+      if (x > 0 && keep(mt)) grid.addEdge({static_cast<Weight>(weightDist(mt)), (x - 1) * side + y, x * side + y});
+      if (y > 0 && keep(mt)) grid.addEdge({static_cast<Weight>(weightDist(mt)), x * side + y - 1, x * side + y});
+    }
+  }
+  Graph G = reorderGraph(grid, VertexOrder::BFS).graph;
+  CompressedGraph probe(G);
+  std::cout << "compressed graph (n=" << G.numVertices() << ", m=" << probe.numEdges() << ", road-like grid)\n";
+  std::cout << "  Graph: " << static_cast<double>(G.memoryBytes()) / probe.numEdges() << " bytes/edge\n";
+  report("boruvkaSpanningForest on Graph", timeMs([&] { boruvkaSpanningForest(G); }));
+  for (auto [encoding, name] : {std::pair {WeightEncoding::Exact, "exact"},
+                                std::pair {WeightEncoding::Float32, "float32"},
+                                std::pair {WeightEncoding::Quantized16, "quantized16"}}) {
+    CompressedGraph C;
+    double build = timeMs([&] { C = CompressedGraph(G, encoding); });
+    std::cout << "  " << name << ": " << C.bytesPerEdge() << " bytes/edge\n";
+    report(std::string("build ") + name, build);
+    report(std::string("compressedBoruvkaForest ") + name, timeMs([&] { compressedBoruvkaForest(C); }));
+    report(std::string("compressedPrimForest ") + name, timeMs([&] { compressedPrimForest(C); }));
+  }
+}
+
+// many small graphs: batchMST vs one Graph and engine call per graph
+void benchBatch() {
+  const int numGraphs = 50'000;
+  std::mt19937 mt {4'242};
+  std::uniform_int_distribution<int> sizeDist {10, 200};
+  std::uniform_real_distribution<double> weightDist {0.0, 1.0};
+  GraphBatch batch;
+  for (int g = 0; g < numGraphs; ++g) {
+    int n = sizeDist(mt);
+    std::uniform_int_distribution<int> indexDist {0, n - 1};
+    std::vector<Graph::Edge> edges(4 * n);
+    for (auto& e : edges) e = {static_cast<Weight>(weightDist(mt)), indexDist(mt), indexDist(mt)};
+    batch.add(n, edges);
+  }
+  std::cout << "batch of small graphs (" << numGraphs << " graphs, 10-200 vertices, m = 4n, "
+            << batch.edges.size() << " edges)\n";
+  auto perGraph = [&batch](auto engine) {
+    for (std::size_t g = 0; g < batch.numGraphs(); ++g) {
+      std::vector<Graph::Edge> slice(batch.edges.begin() + batch.edgeOffset[g],
+                                     batch.edges.begin() + batch.edgeOffset[g + 1]);
+      engine(Graph(batch.numVertices[g], std::move(slice)));
+    }
+  };
+  report("Graph + boruvkaMST per graph", timeMs([&] { perGraph([](const Graph& G) { return boruvkaMST(G); }); }));
+  report("Graph + kktMST per graph", timeMs([&] { perGraph([](const Graph& G) { return kktMST(G); }); }));
+  report("batchMST 1 thread", timeMs([&] { batchMST(batch, 1); }));
+  report("batchMST all threads", timeMs([&] { batchMST(batch); }));
+}
+
+// engines returning a Graph vs the flat SpanningForest
+void benchSpanningForest() {
+  const int N = 250'000;
+  const int numEdges = 1'000'000;
+  Graph G = randomEuclideanGraph(N, numEdges, 4'141);
+  std::cout << "spanning forest result (n=" << N << ", m=" << numEdges << ")\n";
+  report("boruvkaMST", timeMs([&] { boruvkaMST(G); }));
+  report("boruvkaSpanningForest", timeMs([&] { boruvkaSpanningForest(G); }));
+  report("kktMST", timeMs([&] { kktMST(G); }));
+  report("kktSpanningForest", timeMs([&] { kktSpanningForest(G); }));
+}
+
+// NUMA-aware Boruvka: local vs interleaved first touch, pinned vs free threads
+void benchNuma() {
+  const int N = 1'000'000;
+  const int numEdges = 8'000'000;
+  Graph G = randomEuclideanGraph(N, numEdges, 4'545);
+  NumaTopology topology = numaTopology();
+  std::cout << "NUMA-aware Boruvka (n=" << N << ", m=" << numEdges << ", " << topology.numNodes() << " node(s):";
+  for (const auto& cpus : topology.cpus) std::cout << " " << cpus.size();
+  std::cout << " CPUs)\n";
+  if (topology.numNodes() == 1) std::cout << "  single node: both placements are local, times should match\n";
+  report("boruvkaSpanningForest", timeMs([&] { boruvkaSpanningForest(G); }));
+  report("local, pinned", timeMs([&] { numaBoruvkaForest(G, {0, NumaPlacement::Local, true}); }));
+  report("interleaved, pinned", timeMs([&] { numaBoruvkaForest(G, {0, NumaPlacement::Interleaved, true}); }));
+  report("local, not pinned", timeMs([&] { numaBoruvkaForest(G, {0, NumaPlacement::Local, false}); }));
+}
+
+// partitioned MST in worker processes vs the single-process Boruvka
+void benchPartitioned() {
+  const int N = 500'000;
+  const int numEdges = 4'000'000;
+  Graph G = randomEuclideanGraph(N, numEdges, 4'747);
+  std::cout << "partitioned MST (n=" << N << ", m=" << numEdges << ", "
+            << std::thread::hardware_concurrency() << " hardware threads)\n";
+  report("boruvkaSpanningForest", timeMs([&] { boruvkaSpanningForest(G); }));
+  for (int parts : {1, 2, 4, 8}) {
+    report("partitionedMSTForest " + std::to_string(parts) + " partitions",
+           timeMs([&] { partitionedMSTForest(G, {parts, 4}); }));
+  }
+}
+
+// Kruskal with radix sort vs comparison sort, real and small integer weights
+void benchRadixKruskal() {
+  const int N = 500'000;
+  const int numEdges = 4'000'000;
+  Graph real = randomEuclideanGraph(N, numEdges, 4'343);
+  std::mt19937 mt {4'344};
+  std::uniform_int_distribution<int> indexDist {0, N - 1};
+  std::uniform_int_distribution<int> weightDist {0, 1'000};
+  std::vector<Graph::Edge> edges(numEdges);
+  for (auto& e : edges) e = {static_cast<Weight>(weightDist(mt)), indexDist(mt), indexDist(mt)};
+  Graph integer {N, std::move(edges)};
+  auto sortKruskal = [](const Graph& G) {
+    std::vector<Graph::Edge> all;
+    for (int u = 0; u < G.numVertices(); ++u) {
+      for (const auto& e : *G.neighbours(u)) {
+        if (u == e.v1) all.push_back(e);
+      }
+    }
+    std::sort(all.begin(), all.end(), lighterEdge);
+    UnionFind uf(G.numVertices());
+    std::vector<Graph::Edge> forest;
+    for (const auto& e : all) {
+      if (uf.sameSet(e.v1, e.v2)) continue;
+      uf.merge(e.v1, e.v2);
+      forest.push_back(e);
+    }
+    return forest.size();
+  };
+  for (auto [name, G] : {std::pair {"real weights", &real}, std::pair {"integer weights 0-1000", &integer}}) {
+    std::cout << "radix sort Kruskal, " << name << " (n=" << N << ", m=" << numEdges << ")\n";
+    report("std::sort Kruskal", timeMs([&] { sortKruskal(*G); }));
+    report("radixKruskalForest 1 thread", timeMs([&] { radixKruskalForest(*G, 1); }));
+    report("radixKruskalForest all threads", timeMs([&] { radixKruskalForest(*G, 0); }));
+    report("boruvkaSpanningForest", timeMs([&] { boruvkaSpanningForest(*G); }));
+  }
+}
+
+// building a graph edge by edge vs in bulk
+void benchGraphBuild() {
+  const int N = 100'000;
+  const int numEdges = 2'500'000;
+  std::mt19937 mt {31'337};
+  std::uniform_int_distribution<int> indexDist {0, N - 1};
+  std::uniform_real_distribution<double> weightDist {0.0, 1.0};
+  std::vector<Graph::Edge> edges(numEdges);
+  for (auto& e : edges) e = {static_cast<Weight>(weightDist(mt)), indexDist(mt), indexDist(mt)};
+  std::cout << "graph construction (n=" << N << ", m=" << numEdges << ")\n";
+  report("addEdge loop", timeMs([&] {
+    Graph G {N};
+    for (const auto& e : edges) G.addEdge(e);
+  }));
+  report("Graph(n, edges)", timeMs([&] { Graph G {N, edges}; }));
+}
+
+// repeated MST queries on the same graph through MSTCache
+void benchCache() {
+  const int N = 100'000;
+  const int numEdges = 2'500'000;
+  Graph G = randomEuclideanGraph(N, numEdges, 606);
+  std::cout << "MST cache (n=" << N << ", m=" << numEdges << ")\n";
+  report("graphFingerprint 1 thread", timeMs([&] { graphFingerprint(G, 1); }));
+  report("graphFingerprint all threads", timeMs([&] { graphFingerprint(G); }));
+  MSTCache cache(8);
+  report("get (miss, boruvkaMST)", timeMs([&] { cache.get(G); }));
+  report("get (hit)", timeMs([&] { cache.get(G); }));
+}
+
+// peak working memory of kktMST per phase
+void benchMemory() {
+  const int N = 50'000;
+  const int numEdges = 1'000'000;
+  Graph G = randomEuclideanGraph(N, numEdges, 2'718);
+  std::cout << "memory accounting (n=" << N << ", m=" << numEdges << ", input "
+            << G.memoryBytes() / (1 << 20) << " MiB)\n";
+  MemoryTracker tracker;
+  report("kktMST with tracker", timeMs([&] { kktMST(G, &tracker); }));
+  report("kktMST without tracker", timeMs([&] { kktMST(G); }));
+  std::cout << "  peak: " << tracker.peak() / (1 << 20) << " MiB\n";
+  for (const auto& [phase, peak] : tracker.phasePeaks()) {
+    std::cout << "    " << phase << ": " << peak / (1 << 20) << " MiB\n";
+  }
+  std::cout << "  boruvkaMST estimate: " << boruvkaMemoryEstimate(G) / (1 << 20) << " MiB\n";
+}
+
+// task overhead of the work-stealing pool, next to starting a std::thread
+void benchThreadPool() {
+  ThreadPool& pool = globalThreadPool();
+  const int numTasks = 1'000'000;
+  std::cout << "thread pool (" << pool.numThreads() << " threads, " << numTasks << " tasks)\n";
+  std::atomic<int> count {0};
+  double spawn = timeMs([&] {
+    TaskGroup group(pool);
+    for (int i = 0; i < numTasks; ++i) group.run([&count] { count.fetch_add(1, std::memory_order_relaxed); });
+    group.wait();
+  });
+  std::cout << "  TaskGroup run + wait: " << spawn * 1e6 / numTasks << " ns per task\n";
+  double loop = timeMs([&] {
+    pool.parallelFor(0, numTasks, 1, [&count](int, int) { count.fetch_add(1, std::memory_order_relaxed); });
+  });
+  std::cout << "  parallelFor grain 1: " << loop * 1e6 / numTasks << " ns per range\n";
+  const int numThreads = 1'000;
+  double threads = timeMs([&] {
+    for (int i = 0; i < numThreads; ++i) std::thread([&count] { count.fetch_add(1); }).join();
+  });
+  std::cout << "  std::thread start + join: " << threads * 1e6 / numThreads << " ns per thread\n";
+}
+
+// replacement thresholds of every edge, next to the MST itself
+void benchSensitivity() {
+  const int N = 50'000;
+  const int numEdges = 1'000'000;
+  Graph G = randomEuclideanGraph(N, numEdges, 3'939);
+  std::cout << "sensitivity analysis (n=" << N << ", m=" << numEdges << ")\n";
+  Graph mst;
+  report("boruvkaMST", timeMs([&] { mst = boruvkaMST(G); }));
+  report("sensitivityAnalysis(G, mst)", timeMs([&] { sensitivityAnalysis(G, mst); }));
+  Graph small = randomEuclideanGraph(200, 2'000, 3'940);
+  report("kBestSpanningTrees k=100 (n=200, m=2000)", timeMs([&] { kBestSpanningTrees(small, 100); }));
+}
+
+int main(int argc, char* argv[]) {
+  std::vector<std::pair<std::string, std::function<void()> > > benchmarks {
+    {"approximate", benchApproximate},
+    {"batch", benchBatch},
+    {"bottleneck", benchBottleneck},
+    {"build", benchGraphBuild},
+    {"cache", benchCache},
+    {"compressed", benchCompressed},
+    {"dynamic", benchDynamicMST},
+    {"euclidean", benchEuclideanMST},
+    {"forest", benchSpanningForest},
+    {"hierarchy", benchHierarchy},
+    {"kernel", benchBoruvkaKernels},
+    {"memory", benchMemory},
+    {"numa", benchNuma},
+    {"partitioned", benchPartitioned},
+    {"pool", benchThreadPool},
+    {"radix", benchRadixKruskal},
+    {"reorder", benchReorder},
+    {"sensitivity", benchSensitivity},
+  };
+  for (const auto& [name, run] : benchmarks) {
+    bool selected = (argc == 1);
+    for (int i = 1; i < argc; ++i) {
+      if (name == argv[i]) selected = true;
+    }
+    if (selected) run();
+  }
+  return 0;
+}
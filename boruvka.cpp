@@ -1,56 +1,105 @@
 #include "boruvka.hpp"
+#include "boruvka_kernel.hpp"
 #include "union_find.hpp"
+#include "memory_tracker.hpp"
+#include "forest_components.hpp"
+#include "mst_control.hpp"
+#include "spanning_forest.hpp"
 #include "graph.hpp"
 #include <vector>
 
-Graph boruvkaMST(const Graph& G) {
-    int n = G.numVertices();
-    Graph mst(n);
+namespace {
 
-    if (n == 0) return mst;
+//Boruvka rounds on the edges E (shrinking every round) of a graph with n vertices, fills
+//components (if given) from the final UnionFind state and stops at a checkpoint before
+//every round if control is given
+SpanningForest boruvkaRounds(Index n, EdgeArrays& E, ForestComponents* components,
+                             const MSTControl* control) {
+    if (n == 0) {
+        if (components) *components = {};
+        return SpanningForest(n);
+    }
 
     UnionFind UF(n);
+    std::vector<Index> comp(n);             //component label of each vertex
+    std::vector<Index> cheapest;            //position in E of each component's cheapest edge
+    SpanningForest mst(n);                  //spanning forest, edges appended as they are chosen
+    mst.edges.reserve(n - 1);
+    int round = 0;
     //while spanning tree is not completed
     while (UF.numberOfComponents() > 1) {
-        std::vector<Graph::Edge> cheapest(n);
-        std::vector<bool> hasCheapest(n, false); //if component's cheapest edge is set
-        //iterate all edges
-        for (int v = 0; v < n; ++v) {
-            for (auto e : *G.neighbours(v)) {
-                if (v != e.v1) continue;            //avoid duplicate edge
-                int comp1 = UF.find(e.v1);
-                int comp2 = UF.find(e.v2);
-
-                if (comp1 == comp2) continue;       //v1 and v2 are in same component
-
-                //update cheapest edge for component 1
-                if (!hasCheapest[comp1] || e.weight < cheapest[comp1].weight) {
-                    cheapest[comp1] = e;
-                    hasCheapest[comp1] = true;
-                }
-                //update cheapest edge for component 2
-                if (!hasCheapest[comp2] || e.weight < cheapest[comp2].weight) {
-                    cheapest[comp2] = e;
-                    hasCheapest[comp2] = true;
-                }
-            }
+        if (control) control->checkpoint({"boruvka", UF.numberOfComponents(), 0, round++});
+        for (Index v = 0; v < n; ++v) {
+            comp[v] = UF.find(v);           //flatten labels once per round
         }
+        //cheapest edge of every component, edges inside a component are dropped
+        boruvkaScan(E, comp, cheapest);
         
         //merge the vertices of the cheapest edges and add the edges to the spanning tree 
-        int mergedCount = 0;                //number of merges in this Boruvka round
-        for (int v = 0; v < n; ++v) {
-            if (!hasCheapest[v]) continue;
-            auto e = cheapest[v];
-            int comp1 = UF.find(e.v1);
-            int comp2 = UF.find(e.v2);
+        Index mergedCount = 0;                //number of merges in this Boruvka round
+        for (Index v = 0; v < n; ++v) {
+            if (cheapest[v] == -1) continue;
+            auto e = E.edge(cheapest[v]);
+            Index comp1 = UF.find(e.v1);
+            Index comp2 = UF.find(e.v2);
 
             if (comp1 == comp2) continue;
 
             UF.merge(comp1, comp2);
-            mst.addEdge(e);
+            mst.add(e);
             ++mergedCount;
         }
         if (mergedCount == 0) break; //no edges between 2 components left (disconnected)
     }
+    if (components) *components = forestComponents(mst, UF);
     return mst;
-}
\ No newline at end of file
+}
+
+//Boruvka on G, charging its working memory to tracker (if given)
+SpanningForest boruvkaForest(const Graph& G, MemoryTracker* tracker, ForestComponents* components,
+                             const MSTControl* control) {
+    MemoryPhase phase(tracker, "boruvka");
+    MemoryCharge working(tracker, boruvkaMemoryEstimate(G));
+    EdgeArrays E(G);                        //edges as structure of arrays
+    return boruvkaRounds(G.numVertices(), E, components, control);
+}
+
+}  // namespace
+
+Graph boruvkaMST(const Graph& G) {
+    return boruvkaForest(G, nullptr, nullptr, nullptr).toGraph();
+}
+
+Graph boruvkaMST(const Graph& G, MemoryTracker* tracker) {
+    return boruvkaForest(G, tracker, nullptr, nullptr).toGraph();
+}
+
+Graph boruvkaMST(const Graph& G, ForestComponents& components) {
+    return boruvkaForest(G, nullptr, &components, nullptr).toGraph();
+}
+
+Graph boruvkaMST(const Graph& G, const MSTControl& control) {
+    return boruvkaForest(G, nullptr, nullptr, &control).toGraph();
+}
+
+SpanningForest boruvkaSpanningForest(const Graph& G) {
+    return boruvkaForest(G, nullptr, nullptr, nullptr);
+}
+
+SpanningForest boruvkaSpanningForest(Index n, EdgeArrays E) {
+    return boruvkaRounds(n, E, nullptr, nullptr);
+}
+
+std::size_t boruvkaMemoryEstimate(const Graph& G) {
+    std::size_t n = static_cast<std::size_t>(G.numVertices());
+    std::size_t m = 0;
+    for (auto it = G.begin(); it != G.end(); ++it) m += it->size();
+    m /= 2;
+    std::size_t edgeArrays = m * (sizeof(Weight) + 3 * sizeof(Index));
+    //UnionFind, comp, cheapest, best per component and the forest edges
+    std::size_t perVertex = n * (3 * sizeof(Index) + sizeof(int) + sizeof(Weight) + sizeof(Graph::Edge));
+    //output graph: adjacency lists with two entries per forest edge and the ID map
+    std::size_t forest = n * (sizeof(std::vector<Graph::Edge>) + 2 * sizeof(Graph::Edge) +
+                              2 * sizeof(void*) + sizeof(std::pair<const Index, Graph::Edge>));
+    return edgeArrays + perVertex + forest;
+}
@@ -2,7 +2,26 @@
 #define BORUVKA_HPP_ 
 
 #include "graph.hpp"
+#include <cstddef>
+
+class MemoryTracker;
+struct ForestComponents;
+class MSTControl;
+struct SpanningForest;
+struct EdgeArrays;
 
 Graph boruvkaMST(const Graph& G);
+//same, charging its working memory to tracker (may throw MemoryBudgetError)
+Graph boruvkaMST(const Graph& G, MemoryTracker* tracker);
+//same, also returning the trees of the forest in components (taken from the final UnionFind)
+Graph boruvkaMST(const Graph& G, ForestComponents& components);
+//same, with a checkpoint of control before every round (may throw MSTCancelled)
+Graph boruvkaMST(const Graph& G, const MSTControl& control);
+//same forest as a flat edge list, no Graph is built
+SpanningForest boruvkaSpanningForest(const Graph& G);
+//same, straight from the edges of a graph with n vertices (endpoints in 0 .. n - 1), no Graph needed
+SpanningForest boruvkaSpanningForest(Index n, EdgeArrays E);
+//working memory boruvkaMST needs for G: edge arrays, per-vertex state and the output forest
+std::size_t boruvkaMemoryEstimate(const Graph& G);
 
 #endif      // BORUVKA_HPP_
\ No newline at end of file
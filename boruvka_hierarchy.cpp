@@ -0,0 +1,96 @@
+#include "boruvka_hierarchy.hpp"
+#include "boruvka_kernel.hpp"
+#include "spanning_forest.hpp"
+#include "union_find.hpp"
+#include "graph.hpp"
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+namespace {
+
+//edges of the current level with the endpoints they have in G (for the forest)
+struct LevelEdges {
+    EdgeArrays E;
+    std::vector<Index> original1;
+    std::vector<Index> original2;
+};
+
+}  // namespace
+
+std::vector<Index> BoruvkaHierarchy::projection(int level) const {
+    Index n = numVertices.empty() ? 0 : numVertices[0];
+    std::vector<Index> node(n);
+    for (Index v = 0; v < n; ++v) node[v] = v;
+    for (int round = 0; round < level; ++round) {
+        for (auto& x : node) x = superNodeOf(round, x);
+    }
+    return node;
+}
+
+std::size_t BoruvkaHierarchy::memoryBytes() const {
+    return sizeof(BoruvkaHierarchy) + numVertices.capacity() * sizeof(Index) +
+           (mappingOffset.capacity() + edgeOffset.capacity() + chosenOffset.capacity()) * sizeof(std::size_t) +
+           superNode.capacity() * sizeof(Index) + edges.capacity() * sizeof(Graph::Edge) +
+           forest.memoryBytes() - sizeof(SpanningForest);
+}
+
+BoruvkaHierarchy boruvkaHierarchy(const Graph& G) {
+    Index n = G.numVertices();
+    BoruvkaHierarchy H;
+    H.forest = SpanningForest(n);
+    H.numVertices.push_back(n);
+    LevelEdges level {EdgeArrays(G), {}, {}};
+    level.original1 = level.E.v1;
+    level.original2 = level.E.v2;
+
+    std::vector<Index> label;
+    std::vector<Index> cheapest;
+    while (level.E.size() > 0) {
+        //cheapest edge of every vertex; a level has no self-loops, so the scan keeps every position
+        label.resize(n);
+        for (Index v = 0; v < n; ++v) label[v] = v;
+        boruvkaScan(level.E, label, cheapest);
+        UnionFind UF(n);
+        for (Index v = 0; v < n; ++v) {
+            if (cheapest[v] == -1) continue;
+            Index i = cheapest[v];
+            Index root1 = UF.find(level.E.v1[i]);
+            Index root2 = UF.find(level.E.v2[i]);
+            if (root1 == root2) continue;               //chosen by both endpoints
+            UF.merge(root1, root2);
+            H.forest.add({level.E.weight[i], level.original1[i], level.original2[i], level.E.edgeId[i]});
+        }
+        H.chosenOffset.push_back(H.forest.edges.size());
+
+        //supernodes numbered in order of their first vertex
+        std::vector<Index> rootNode(n, -1);
+        Index next = 0;
+        for (Index v = 0; v < n; ++v) {
+            Index root = UF.find(v);
+            if (rootNode[root] == -1) rootNode[root] = next++;
+            H.superNode.push_back(rootNode[root]);
+        }
+        H.mappingOffset.push_back(H.superNode.size());
+        const Index* node = H.superNode.data() + H.mappingOffset[H.mappingOffset.size() - 2];
+
+        //lightest edge between every pair of supernodes, smaller endpoint first
+        LevelEdges contracted;
+        for (Index i : contractEdges(level.E, node, next)) {
+            Index a = node[level.E.v1[i]];
+            Index b = node[level.E.v2[i]];
+            contracted.E.weight.push_back(level.E.weight[i]);
+            contracted.E.v1.push_back(std::min(a, b));
+            contracted.E.v2.push_back(std::max(a, b));
+            contracted.E.edgeId.push_back(level.E.edgeId[i]);
+            contracted.original1.push_back(level.original1[i]);
+            contracted.original2.push_back(level.original2[i]);
+        }
+        for (Index j = 0; j < contracted.E.size(); ++j) H.edges.push_back(contracted.E.edge(j));
+        H.edgeOffset.push_back(H.edges.size());
+        H.numVertices.push_back(next);
+        level = std::move(contracted);
+        n = next;
+    }
+    return H;
+}
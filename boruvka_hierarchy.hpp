@@ -0,0 +1,42 @@
+#ifndef BORUVKA_HIERARCHY_HPP_
+#define BORUVKA_HIERARCHY_HPP_
+
+#include "graph.hpp"
+#include "spanning_forest.hpp"
+#include <cstddef>
+#include <vector>
+
+//Borůvka contraction hierarchy of a graph, all levels in flat arrays
+//level 0 is G (self-loops dropped); round r contracts the cheapest edge of every vertex of
+//level r, which gives level r + 1: its vertices are the resulting components, numbered in order
+//of their first vertex, and its edges the lightest edge between every pair of them
+//the rounds stop at the first level without edges, one vertex per tree of the forest
+struct BoruvkaHierarchy {
+    std::vector<Index> numVertices;                 //vertices of every level, 0 .. numRounds()
+    std::vector<std::size_t> mappingOffset {0};     //round r: superNode[mappingOffset[r] .. mappingOffset[r + 1])
+    std::vector<Index> superNode;                   //vertex of level r + 1 containing vertex v of level r
+    std::vector<std::size_t> edgeOffset {0};        //round r: edges[edgeOffset[r] .. edgeOffset[r + 1])
+    std::vector<Graph::Edge> edges;                 //edges of level r + 1: v1 < v2 there, weight and ID of G's edge
+    std::vector<std::size_t> chosenOffset {0};      //round r: forest.edges[chosenOffset[r] .. chosenOffset[r + 1])
+    SpanningForest forest;                          //minimum spanning forest of G, edges of G in round order
+
+    int numRounds() const {
+        return static_cast<int>(mappingOffset.size()) - 1;
+    }
+    //vertex of level round + 1 containing vertex v of level round
+    Index superNodeOf(int round, Index v) const {
+        return superNode[mappingOffset[round] + v];
+    }
+    //vertex of the given level (0 .. numRounds()) containing each vertex of G
+    std::vector<Index> projection(int level) const;
+    //approximate footprint in bytes
+    std::size_t memoryBytes() const;
+};
+
+//run Borůvka to completion and keep every level
+//cheapest edges come from boruvkaScan (ties broken by edge ID), so the forest is the one of
+//boruvkaMST; parallel edges of a level are reduced to the lightest by contractEdges (the bucket
+//pass by first endpoint boruvkaStep uses too), O(m + n) per round and O((m + n) log n) in total
+BoruvkaHierarchy boruvkaHierarchy(const Graph& G);
+
+#endif      // BORUVKA_HIERARCHY_HPP_
@@ -0,0 +1,374 @@
+#include "boruvka_kernel.hpp"
+#include "graph.hpp"
+#include <vector>
+#include <atomic>
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__)) && \
+    !defined(MST_INDEX_64)
+#define MST_X86_SIMD 1
+#include <immintrin.h>
+#endif
+
+EdgeArrays::EdgeArrays(const Graph& G) {
+    std::size_t m = 0;
+    for (auto it = G.begin(); it != G.end(); ++it) m += it->size();
+    weight.reserve(m / 2 + 1);
+    v1.reserve(m / 2 + 1);
+    v2.reserve(m / 2 + 1);
+    edgeId.reserve(m / 2 + 1);
+    for (Index u = 0; u < G.numVertices(); ++u) {
+        for (const auto& e : *G.neighbours(u)) {
+            if (u != e.v1) continue;                    //avoid duplicate edge
+            if (e.v1 == e.v2) continue;                 //self-loops never join two components
+            weight.push_back(e.weight);
+            v1.push_back(e.v1);
+            v2.push_back(e.v2);
+            edgeId.push_back(e.edgeId);
+        }
+    }
+}
+
+namespace {
+
+//new cheapest candidate at position pos for components c1 and c2, compared by (weight, edge ID)
+inline void update(const EdgeArrays& E, Index pos, Index c1, Index c2, Index* cheapest, Weight* best) {
+    Weight w = E.weight[pos];
+    Index id = E.edgeId[pos];
+    for (Index c : {c1, c2}) {
+        if (cheapest[c] == -1 || w < best[c] || (w == best[c] && id < E.edgeId[cheapest[c]])) {
+            cheapest[c] = pos;
+            best[c] = w;
+        }
+    }
+}
+
+//scalar scan of positions [begin, end), surviving edges are written from position out on
+Index scanScalar(EdgeArrays& E, Index begin, Index end, Index out,
+                 const Index* comp, Index* cheapest, Weight* best) {
+    for (Index i = begin; i < end; ++i) {
+        Index c1 = comp[E.v1[i]];
+        Index c2 = comp[E.v2[i]];
+        if (c1 == c2) continue;                         //inside a component: drop for good
+        if (out != i) {
+            E.weight[out] = E.weight[i];
+            E.v1[out] = E.v1[i];
+            E.v2[out] = E.v2[i];
+            E.edgeId[out] = E.edgeId[i];
+        }
+        update(E, out, c1, c2, cheapest, best);
+        ++out;
+    }
+    return out;
+}
+
+#ifdef MST_X86_SIMD
+
+constexpr bool SIMD_WEIGHT = sizeof(Weight) == 4 || sizeof(Weight) == 8;
+//the kernels address the weights as Weight* + Index (never Index * sizeof(Weight) in 32 bits),
+//which stays inside ptrdiff_t for every edge list an Index can count
+static_assert(std::numeric_limits<Index>::max() <= std::numeric_limits<std::ptrdiff_t>::max() / sizeof(Weight));
+
+//permutations moving the selected lanes to the front (AVX2 has no compress instruction)
+struct CompressTables {
+    alignas(32) std::int32_t perm32[256][8];    //8 x 32-bit lanes, indexed by lane mask
+    alignas(32) std::int32_t perm64[16][8];     //4 x 64-bit lanes (as 32-bit pairs)
+};
+
+const CompressTables& compressTables() {
+    static const CompressTables tables = [] {
+        CompressTables t {};
+        for (int mask = 0; mask < 256; ++mask) {
+            int k = 0;
+            for (int lane = 0; lane < 8; ++lane) {
+                if (mask & (1 << lane)) t.perm32[mask][k++] = lane;
+            }
+            while (k < 8) t.perm32[mask][k++] = 0;
+        }
+        for (int mask = 0; mask < 16; ++mask) {
+            int k = 0;
+            for (int lane = 0; lane < 4; ++lane) {
+                if (mask & (1 << lane)) {
+                    t.perm64[mask][k++] = 2 * lane;
+                    t.perm64[mask][k++] = 2 * lane + 1;
+                }
+            }
+            while (k < 8) t.perm64[mask][k++] = 0;
+        }
+        return t;
+    }();
+    return tables;
+}
+
+__attribute__((target("avx2")))
+Index scanAVX2(EdgeArrays& E, const Index* comp, Index* cheapest, Weight* best) {
+    const Index m = E.size();
+    const CompressTables& T = compressTables();
+    auto* v1 = reinterpret_cast<std::int32_t*>(E.v1.data());
+    auto* v2 = reinterpret_cast<std::int32_t*>(E.v2.data());
+    auto* ids = reinterpret_cast<std::int32_t*>(E.edgeId.data());
+    Weight* w = E.weight.data();
+    const auto* labels = reinterpret_cast<const int*>(comp);
+    alignas(32) std::int32_t c1s[8];
+    alignas(32) std::int32_t c2s[8];
+    Index out = 0;
+    Index i = 0;
+    for (; i + 8 <= m; i += 8) {
+        __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(v1 + i));
+        __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(v2 + i));
+        __m256i ca = _mm256_i32gather_epi32(labels, a, 4);
+        __m256i cb = _mm256_i32gather_epi32(labels, b, 4);
+        int live = ~_mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpeq_epi32(ca, cb))) & 0xFF;
+        if (live == 0) continue;
+
+        //lanes that can improve either component (<=: best only shrinks, ties settled below)
+        int improve = live;
+        if constexpr (std::is_same_v<Weight, float>) {
+            const auto* bestF = reinterpret_cast<const float*>(best);
+            __m256 wv = _mm256_loadu_ps(reinterpret_cast<const float*>(w + i));
+            __m256 ba = _mm256_i32gather_ps(bestF, ca, 4);
+            __m256 bb = _mm256_i32gather_ps(bestF, cb, 4);
+            improve &= _mm256_movemask_ps(_mm256_or_ps(_mm256_cmp_ps(wv, ba, _CMP_LE_OQ),
+                                                       _mm256_cmp_ps(wv, bb, _CMP_LE_OQ)));
+        }
+        else if constexpr (std::is_same_v<Weight, double>) {
+            const auto* bestD = reinterpret_cast<const double*>(best);
+            const auto* wd = reinterpret_cast<const double*>(w + i);
+            __m256d wlo = _mm256_loadu_pd(wd);
+            __m256d whi = _mm256_loadu_pd(wd + 4);
+            __m256d balo = _mm256_i32gather_pd(bestD, _mm256_castsi256_si128(ca), 8);
+            __m256d bahi = _mm256_i32gather_pd(bestD, _mm256_extracti128_si256(ca, 1), 8);
+            __m256d bblo = _mm256_i32gather_pd(bestD, _mm256_castsi256_si128(cb), 8);
+            __m256d bbhi = _mm256_i32gather_pd(bestD, _mm256_extracti128_si256(cb, 1), 8);
+            int lo = _mm256_movemask_pd(_mm256_or_pd(_mm256_cmp_pd(wlo, balo, _CMP_LE_OQ),
+                                                     _mm256_cmp_pd(wlo, bblo, _CMP_LE_OQ)));
+            int hi = _mm256_movemask_pd(_mm256_or_pd(_mm256_cmp_pd(whi, bahi, _CMP_LE_OQ),
+                                                     _mm256_cmp_pd(whi, bbhi, _CMP_LE_OQ)));
+            improve &= lo | (hi << 4);
+        }
+
+        //compress the surviving lanes to position out (out <= i, so only consumed slots are hit)
+        __m256i perm = _mm256_load_si256(reinterpret_cast<const __m256i*>(T.perm32[live]));
+        __m256i idv = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(ids + i));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(v1 + out), _mm256_permutevar8x32_epi32(a, perm));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(v2 + out), _mm256_permutevar8x32_epi32(b, perm));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(ids + out), _mm256_permutevar8x32_epi32(idv, perm));
+        if constexpr (sizeof(Weight) == 4) {
+            __m256i wv = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(w + i));
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(w + out), _mm256_permutevar8x32_epi32(wv, perm));
+        }
+        else {
+            int mlo = live & 0xF;
+            int mhi = live >> 4;
+            __m256i wlo = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(w + i));
+            __m256i whi = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(w + i + 4));
+            __m256i plo = _mm256_load_si256(reinterpret_cast<const __m256i*>(T.perm64[mlo]));
+            __m256i phi = _mm256_load_si256(reinterpret_cast<const __m256i*>(T.perm64[mhi]));
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(w + out), _mm256_permutevar8x32_epi32(wlo, plo));
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(w + out + __builtin_popcount(mlo)),
+                                _mm256_permutevar8x32_epi32(whi, phi));
+        }
+
+        //commit improving lanes in scan order
+        if (improve) {
+            _mm256_store_si256(reinterpret_cast<__m256i*>(c1s), ca);
+            _mm256_store_si256(reinterpret_cast<__m256i*>(c2s), cb);
+            while (improve) {
+                int k = __builtin_ctz(improve);
+                improve &= improve - 1;
+                Index pos = out + __builtin_popcount(live & ((1 << k) - 1));
+                update(E, pos, c1s[k], c2s[k], cheapest, best);
+            }
+        }
+        out += __builtin_popcount(live);
+    }
+    return scanScalar(E, i, m, out, comp, cheapest, best);
+}
+
+__attribute__((target("avx512f")))
+Index scanAVX512(EdgeArrays& E, const Index* comp, Index* cheapest, Weight* best) {
+    const Index m = E.size();
+    auto* v1 = reinterpret_cast<std::int32_t*>(E.v1.data());
+    auto* v2 = reinterpret_cast<std::int32_t*>(E.v2.data());
+    auto* ids = reinterpret_cast<std::int32_t*>(E.edgeId.data());
+    Weight* w = E.weight.data();
+    const auto* labels = reinterpret_cast<const int*>(comp);
+    alignas(64) std::int32_t c1s[16];
+    alignas(64) std::int32_t c2s[16];
+    Index out = 0;
+    Index i = 0;
+    for (; i + 16 <= m; i += 16) {
+        __m512i a = _mm512_loadu_si512(v1 + i);
+        __m512i b = _mm512_loadu_si512(v2 + i);
+        __m512i ca = _mm512_i32gather_epi32(a, labels, 4);
+        __m512i cb = _mm512_i32gather_epi32(b, labels, 4);
+        __mmask16 live = _mm512_cmpneq_epi32_mask(ca, cb);
+        if (live == 0) continue;
+
+        __mmask16 improve = live;
+        if constexpr (std::is_same_v<Weight, float>) {
+            const auto* bestF = reinterpret_cast<const float*>(best);
+            __m512 wv = _mm512_loadu_ps(reinterpret_cast<const float*>(w + i));
+            __m512 ba = _mm512_mask_i32gather_ps(_mm512_setzero_ps(), live, ca, bestF, 4);
+            __m512 bb = _mm512_mask_i32gather_ps(_mm512_setzero_ps(), live, cb, bestF, 4);
+            improve = _mm512_mask_cmp_ps_mask(live, wv, ba, _CMP_LE_OQ) |
+                      _mm512_mask_cmp_ps_mask(live, wv, bb, _CMP_LE_OQ);
+        }
+        else if constexpr (std::is_same_v<Weight, double>) {
+            const auto* bestD = reinterpret_cast<const double*>(best);
+            const auto* wd = reinterpret_cast<const double*>(w + i);
+            __mmask8 llo = static_cast<__mmask8>(live);
+            __mmask8 lhi = static_cast<__mmask8>(live >> 8);
+            __m512d wlo = _mm512_loadu_pd(wd);
+            __m512d whi = _mm512_loadu_pd(wd + 8);
+            __m512d zero = _mm512_setzero_pd();
+            __m512d balo = _mm512_mask_i32gather_pd(zero, llo, _mm512_castsi512_si256(ca), bestD, 8);
+            __m512d bahi = _mm512_mask_i32gather_pd(zero, lhi, _mm512_extracti64x4_epi64(ca, 1), bestD, 8);
+            __m512d bblo = _mm512_mask_i32gather_pd(zero, llo, _mm512_castsi512_si256(cb), bestD, 8);
+            __m512d bbhi = _mm512_mask_i32gather_pd(zero, lhi, _mm512_extracti64x4_epi64(cb, 1), bestD, 8);
+            __mmask8 lo = _mm512_mask_cmp_pd_mask(llo, wlo, balo, _CMP_LE_OQ) |
+                          _mm512_mask_cmp_pd_mask(llo, wlo, bblo, _CMP_LE_OQ);
+            __mmask8 hi = _mm512_mask_cmp_pd_mask(lhi, whi, bahi, _CMP_LE_OQ) |
+                          _mm512_mask_cmp_pd_mask(lhi, whi, bbhi, _CMP_LE_OQ);
+            improve = static_cast<__mmask16>(lo | (hi << 8));
+        }
+
+        //compress the surviving lanes to position out
+        __m512i idv = _mm512_loadu_si512(ids + i);
+        _mm512_mask_compressstoreu_epi32(v1 + out, live, a);
+        _mm512_mask_compressstoreu_epi32(v2 + out, live, b);
+        _mm512_mask_compressstoreu_epi32(ids + out, live, idv);
+        if constexpr (sizeof(Weight) == 4) {
+            __m512i wv = _mm512_loadu_si512(w + i);
+            _mm512_mask_compressstoreu_epi32(w + out, live, wv);
+        }
+        else {
+            __mmask8 llo = static_cast<__mmask8>(live);
+            __mmask8 lhi = static_cast<__mmask8>(live >> 8);
+            __m512i wlo = _mm512_loadu_si512(w + i);
+            __m512i whi = _mm512_loadu_si512(w + i + 8);
+            _mm512_mask_compressstoreu_epi64(w + out, llo, wlo);
+            _mm512_mask_compressstoreu_epi64(w + out + __builtin_popcount(llo), lhi, whi);
+        }
+
+        //commit improving lanes in scan order
+        if (improve) {
+            _mm512_store_si512(c1s, ca);
+            _mm512_store_si512(c2s, cb);
+            unsigned bits = improve;
+            while (bits) {
+                int k = __builtin_ctz(bits);
+                bits &= bits - 1;
+                Index pos = out + __builtin_popcount(live & ((1u << k) - 1));
+                update(E, pos, c1s[k], c2s[k], cheapest, best);
+            }
+        }
+        out += __builtin_popcount(live);
+    }
+    return scanScalar(E, i, m, out, comp, cheapest, best);
+}
+
+#endif  // MST_X86_SIMD
+
+BoruvkaKernel bestSupported() {
+#ifdef MST_X86_SIMD
+    if (SIMD_WEIGHT) {
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx512f")) return BoruvkaKernel::AVX512;
+        if (__builtin_cpu_supports("avx2")) return BoruvkaKernel::AVX2;
+    }
+#endif
+    return BoruvkaKernel::Scalar;
+}
+
+bool supported(BoruvkaKernel kernel) {
+    switch (kernel) {
+        case BoruvkaKernel::Scalar: return true;
+        case BoruvkaKernel::AVX2: return bestSupported() != BoruvkaKernel::Scalar;
+        case BoruvkaKernel::AVX512: return bestSupported() == BoruvkaKernel::AVX512;
+        default: return false;
+    }
+}
+
+std::atomic<BoruvkaKernel>& currentKernel() {
+    static std::atomic<BoruvkaKernel> kernel {bestSupported()};
+    return kernel;
+}
+
+}  // namespace
+
+BoruvkaKernel setBoruvkaKernel(BoruvkaKernel kernel) {
+    if (!supported(kernel)) kernel = bestSupported();
+    currentKernel() = kernel;
+    return kernel;
+}
+
+BoruvkaKernel boruvkaKernel() {
+    return currentKernel();
+}
+
+void boruvkaScan(EdgeArrays& E, const std::vector<Index>& comp, std::vector<Index>& cheapest) {
+    std::size_t n = comp.size();
+    cheapest.assign(n, -1);
+    std::vector<Weight> best(n, WEIGHT_MAX);
+    Index out = 0;
+    switch (boruvkaKernel()) {
+#ifdef MST_X86_SIMD
+        case BoruvkaKernel::AVX512:
+            out = scanAVX512(E, comp.data(), cheapest.data(), best.data());
+            break;
+        case BoruvkaKernel::AVX2:
+            out = scanAVX2(E, comp.data(), cheapest.data(), best.data());
+            break;
+#endif
+        default:
+            out = scanScalar(E, 0, E.size(), 0, comp.data(), cheapest.data(), best.data());
+            break;
+    }
+    E.weight.resize(out);
+    E.v1.resize(out);
+    E.v2.resize(out);
+    E.edgeId.resize(out);
+}
+
+std::vector<Index> contractEdges(const EdgeArrays& E, const Index* node, Index numSuperNodes) {
+    //edges between supernodes, bucketed by smaller endpoint; within a bucket best[b] is the
+    //slot in kept of the lightest edge to b so far, valid while owner[b] is the bucket
+    std::vector<std::size_t> start(numSuperNodes + 1, 0);
+    for (Index i = 0; i < E.size(); ++i) {
+        Index a = node[E.v1[i]];
+        Index b = node[E.v2[i]];
+        if (a != b) ++start[std::min(a, b) + 1];
+    }
+    for (Index s = 0; s < numSuperNodes; ++s) start[s + 1] += start[s];
+    std::vector<Index> bucketed(start[numSuperNodes]);
+    for (Index i = 0; i < E.size(); ++i) {
+        Index a = node[E.v1[i]];
+        Index b = node[E.v2[i]];
+        if (a != b) bucketed[start[std::min(a, b)]++] = i;
+    }
+    std::vector<Index> kept;
+    std::vector<Index> owner(numSuperNodes, -1);
+    std::vector<Index> best(numSuperNodes);
+    std::size_t first = 0;                              //start of bucket a (start[] now holds the ends)
+    for (Index a = 0; a < numSuperNodes; ++a) {
+        for (std::size_t k = first; k < start[a]; ++k) {
+            Index i = bucketed[k];
+            Index b = std::max(node[E.v1[i]], node[E.v2[i]]);
+            if (owner[b] != a) {
+                owner[b] = a;
+                best[b] = static_cast<Index>(kept.size());
+                kept.push_back(i);
+            }
+            else if (lighterEdge(E.edge(i), E.edge(kept[best[b]]))) {
+                kept[best[b]] = i;
+            }
+        }
+        first = start[a];
+    }
+    return kept;
+}
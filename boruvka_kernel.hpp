@@ -0,0 +1,51 @@
+#ifndef BORUVKA_KERNEL_HPP_
+#define BORUVKA_KERNEL_HPP_
+
+#include "graph.hpp"
+#include <vector>
+
+//Structure-of-arrays copy of the edges of a graph (each undirected edge once, in the order
+//boruvkaMST used to scan the adjacency lists, without self-loops) for the vectorized Borůvka scan
+struct EdgeArrays {
+    std::vector<Weight> weight;
+    std::vector<Index> v1;
+    std::vector<Index> v2;
+    std::vector<Index> edgeId;
+
+    EdgeArrays() = default;
+    explicit EdgeArrays(const Graph& G);
+
+    Index size() const {
+        return static_cast<Index>(weight.size());
+    }
+    //edge at position i
+    Graph::Edge edge(Index i) const {
+        return {weight[i], v1[i], v2[i], edgeId[i]};
+    }
+};
+
+//implementations of the scan, Auto picks the best one the CPU supports
+enum class BoruvkaKernel { Auto, Scalar, AVX2, AVX512 };
+
+//select the kernel used by boruvkaScan, returns the kernel actually in use
+//(an unsupported choice falls back to the best supported one)
+BoruvkaKernel setBoruvkaKernel(BoruvkaKernel kernel);
+//kernel currently in use
+BoruvkaKernel boruvkaKernel();
+
+//One Borůvka scan over E with flattened component labels comp (comp[v]: label of v's component)
+//edges inside a component are dropped from E for good (E is compacted in place), and for every
+//label c, cheapest[c] is the position in E of the lightest edge leaving c (-1 if none)
+//edges are compared with lighterEdge (weight, then edge ID), so every kernel picks the same edges
+//and the chosen edges never close a cycle, even among equal weights
+//the SIMD kernels need 32-bit indices and vectorize the label gather, self-loop filter and
+//the weight comparison; improving edges are then committed in scan order
+void boruvkaScan(EdgeArrays& E, const std::vector<Index>& comp, std::vector<Index>& cheapest);
+
+//Contraction of E onto supernodes (node[v]: supernode 0 .. numSuperNodes - 1 of vertex v)
+//edges inside a supernode are dropped and parallel edges between two supernodes reduced to the
+//lightest (lighterEdge), with a bucket pass by smaller endpoint in O(m + numSuperNodes)
+//returns the positions in E of the kept edges, by smaller endpoint and then first appearance
+std::vector<Index> contractEdges(const EdgeArrays& E, const Index* node, Index numSuperNodes);
+
+#endif      // BORUVKA_KERNEL_HPP_
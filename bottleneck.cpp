@@ -0,0 +1,208 @@
+#include "bottleneck.hpp"
+#include "clustering.hpp"
+#include "graph.hpp"
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+#include <fstream>
+#include <iostream>
+#include <utility>
+
+namespace {
+
+//file header of BottleneckOracle::save
+constexpr char MAGIC[4] = {'M', 'S', 'T', 'B'};
+constexpr std::uint32_t FORMAT_VERSION = 1;
+
+template <typename T>
+void writeVector(std::ofstream& out, const std::vector<T>& values) {
+    std::uint64_t count = values.size();
+    out.write(reinterpret_cast<const char*>(&count), sizeof(count));
+    out.write(reinterpret_cast<const char*>(values.data()), static_cast<std::streamsize>(count * sizeof(T)));
+}
+
+template <typename T>
+bool readVector(std::ifstream& in, std::vector<T>& values, std::uint64_t expected) {
+    std::uint64_t count = 0;
+    if (!in.read(reinterpret_cast<char*>(&count), sizeof(count)) || count != expected) return false;
+    values.resize(count);
+    return static_cast<bool>(in.read(reinterpret_cast<char*>(values.data()),
+                                     static_cast<std::streamsize>(count * sizeof(T))));
+}
+
+}  // namespace
+
+BottleneckOracle::BottleneckOracle(const Graph& F) {
+    KruskalTree krt = buildKruskalTree(F);
+    n = krt.numLeaves;
+    Index nodes = krt.numNodes();
+    position.assign(n, -1);
+    component.assign(n, -1);
+    gap.reserve(n > 0 ? n - 1 : 0);
+    height.assign(krt.height.begin() + n, krt.height.end());
+    edgeId.assign(krt.edgeId.begin() + n, krt.edgeId.end());
+
+    //in-order walk of every tree, leaves get consecutive positions
+    Index next = 0;
+    std::vector<Index> stack;
+    std::vector<Index> leaves;
+    for (Index root = 0; root < nodes; ++root) {
+        if (krt.parent[root] != -1) continue;
+        if (next > 0) gap.push_back(-1);                //no path into the previous tree
+        leaves.clear();
+        Index current = root;
+        while (current != -1 || !stack.empty()) {
+            while (current != -1) {
+                stack.push_back(current);
+                current = krt.left[current];
+            }
+            current = stack.back();
+            stack.pop_back();
+            if (current < n) {
+                position[current] = next++;
+                leaves.push_back(current);
+            }
+            else {
+                gap.push_back(current);
+            }
+            current = krt.right[current];
+        }
+        Index smallest = *std::min_element(leaves.begin(), leaves.end());
+        for (Index v : leaves) component[v] = smallest;
+    }
+    buildTable();
+}
+
+Index BottleneckOracle::numVertices() const {
+    return n;
+}
+
+bool BottleneckOracle::connected(Index u, Index v) const {
+    return component[u] == component[v];
+}
+
+Weight BottleneckOracle::bottleneck(Index u, Index v) const {
+    if (!connected(u, v)) return WEIGHT_MAX;
+    if (u == v) return WEIGHT_MIN;
+    return height[lcaNode(u, v) - n];
+}
+
+Index BottleneckOracle::bottleneckEdge(Index u, Index v) const {
+    if (u == v || !connected(u, v)) return -1;
+    return edgeId[lcaNode(u, v) - n];
+}
+
+bool BottleneckOracle::save(const std::string& file) const {
+    std::ofstream out {file, std::ios::binary};
+    if (!out) {
+        std::cerr << file << " could not be opened\n";
+        return false;
+    }
+    out.write(MAGIC, sizeof(MAGIC));
+    out.write(reinterpret_cast<const char*>(&FORMAT_VERSION), sizeof(FORMAT_VERSION));
+    std::uint8_t sizes[2] = {sizeof(Weight), sizeof(Index)};
+    out.write(reinterpret_cast<const char*>(sizes), sizeof(sizes));
+    std::uint64_t count = static_cast<std::uint64_t>(n);
+    out.write(reinterpret_cast<const char*>(&count), sizeof(count));
+    writeVector(out, position);
+    writeVector(out, component);
+    writeVector(out, gap);
+    writeVector(out, height);
+    writeVector(out, edgeId);
+    return static_cast<bool>(out);
+}
+
+bool BottleneckOracle::load(const std::string& file) {
+    std::ifstream in {file, std::ios::binary};
+    if (!in) {
+        std::cerr << file << " could not be opened\n";
+        return false;
+    }
+    char magic[sizeof(MAGIC)];
+    std::uint32_t version = 0;
+    std::uint8_t sizes[2] = {0, 0};
+    std::uint64_t count = 0;
+    if (!in.read(magic, sizeof(magic)) || !std::equal(magic, magic + sizeof(magic), MAGIC) ||
+        !in.read(reinterpret_cast<char*>(&version), sizeof(version)) || version != FORMAT_VERSION ||
+        !in.read(reinterpret_cast<char*>(sizes), sizeof(sizes)) ||
+        sizes[0] != sizeof(Weight) || sizes[1] != sizeof(Index) ||
+        !in.read(reinterpret_cast<char*>(&count), sizeof(count))) {
+        return false;
+    }
+    //read everything before touching the oracle
+    BottleneckOracle loaded;
+    loaded.n = static_cast<Index>(count);
+    std::uint64_t numGaps = count > 0 ? count - 1 : 0;
+    if (!readVector(in, loaded.position, count) || !readVector(in, loaded.component, count) ||
+        !readVector(in, loaded.gap, numGaps)) {
+        return false;
+    }
+    auto internal = static_cast<std::uint64_t>(
+        std::count_if(loaded.gap.begin(), loaded.gap.end(), [](Index node) { return node != -1; }));
+    if (!readVector(in, loaded.height, internal) || !readVector(in, loaded.edgeId, internal)) return false;
+    //indices must stay inside the tables, positions a permutation, components the trees of gap
+    Index leaves = loaded.n;
+    auto inRange = [leaves](Index x) { return x >= 0 && x < leaves; };
+    auto isInternal = [leaves, internal](Index node) {
+        return node == -1 || (node >= leaves && static_cast<std::uint64_t>(node - leaves) < internal);
+    };
+    if (!std::all_of(loaded.position.begin(), loaded.position.end(), inRange) ||
+        !std::all_of(loaded.component.begin(), loaded.component.end(), inRange) ||
+        !std::all_of(loaded.gap.begin(), loaded.gap.end(), isInternal)) {
+        return false;
+    }
+    std::vector<Index> leafAt(leaves, -1);
+    for (Index v = 0; v < leaves; ++v) {
+        if (leafAt[loaded.position[v]] != -1) return false;
+        leafAt[loaded.position[v]] = v;
+    }
+    //trees are the runs of leaves between -1 gaps: component must agree with them, or a query
+    //between "connected" vertices of different trees would find no internal node
+    for (Index first = 0; first < leaves;) {
+        Index last = first;
+        while (last + 1 < leaves && loaded.gap[last] != -1) ++last;
+        Index smallest = *std::min_element(leafAt.begin() + first, leafAt.begin() + last + 1);
+        for (Index p = first; p <= last; ++p) {
+            if (loaded.component[leafAt[p]] != smallest) return false;
+        }
+        first = last + 1;
+    }
+    loaded.buildTable();
+    *this = std::move(loaded);
+    return true;
+}
+
+std::size_t BottleneckOracle::memoryBytes() const {
+    return sizeof(BottleneckOracle) +
+           (position.capacity() + component.capacity() + gap.capacity() + edgeId.capacity() + table.capacity()) * sizeof(Index) +
+           height.capacity() * sizeof(Weight);
+}
+
+
+//helper functions
+
+Index BottleneckOracle::lcaNode(Index u, Index v) const {
+    Index a = position[u];
+    Index b = position[v];
+    if (a > b) std::swap(a, b);
+    //gaps a .. b - 1 lie between the two leaves
+    auto length = static_cast<std::size_t>(b - a);
+    int k = static_cast<int>(std::bit_width(length)) - 1;
+    std::size_t stride = gap.size();
+    return std::max(table[k * stride + a], table[k * stride + b - (Index {1} << k)]);
+}
+
+void BottleneckOracle::buildTable() {
+    std::size_t stride = gap.size();
+    levels = static_cast<int>(std::bit_width(stride));
+    table.assign(levels * stride, -1);
+    std::copy(gap.begin(), gap.end(), table.begin());
+    for (int k = 1; k < levels; ++k) {
+        std::size_t half = std::size_t {1} << (k - 1);
+        const Index* below = table.data() + (k - 1) * stride;
+        Index* row = table.data() + k * stride;
+        for (std::size_t i = 0; i + 2 * half <= stride; ++i) {
+            row[i] = std::max(below[i], below[i + half]);
+        }
+    }
+}
@@ -0,0 +1,56 @@
+#ifndef BOTTLENECK_HPP_
+#define BOTTLENECK_HPP_
+
+#include "graph.hpp"
+#include <vector>
+#include <string>
+#include <cstddef>
+
+//Minimax (bottleneck) path queries over a minimum spanning forest
+//the lightest possible maximum edge on any u-v path of G is the heaviest edge on the forest path,
+//i.e. the Kruskal reconstruction tree node at the LCA of u and v.
+//leaves are laid out in in-order of the Kruskal tree, so the internal node between consecutive
+//leaves is their LCA and the LCA of any two leaves is the largest node ID between them:
+//a sparse table over those n - 1 gaps answers queries in O(1), O(n log n) preprocessing.
+//queries are const and touch no shared state, any number of threads may run them at once
+class BottleneckOracle {
+    public:
+    //default constructor
+    BottleneckOracle() = default;
+    //build from forest F (e.g. the output of boruvkaMST or kktMST)
+    explicit BottleneckOracle(const Graph& F);
+
+    Index numVertices() const;
+
+    //are u and v in the same tree?
+    bool connected(Index u, Index v) const;
+    //heaviest edge weight on the forest path between u and v
+    //WEIGHT_MIN if u == v, WEIGHT_MAX if they are not connected (as LCA::maxEdgeWeight)
+    Weight bottleneck(Index u, Index v) const;
+    //ID of that edge, -1 if u == v or not connected
+    Index bottleneckEdge(Index u, Index v) const;
+
+    //binary file with the query tables (sparse table is rebuilt on load)
+    //false if the file can't be opened or doesn't hold an oracle of this build's Weight/Index
+    bool save(const std::string& file) const;
+    bool load(const std::string& file);
+
+    //approximate footprint in bytes (dominated by the sparse table, O(n log n))
+    std::size_t memoryBytes() const;
+
+    private:
+    Index n {0};
+    std::vector<Index> position;        //position of each vertex in the leaf order
+    std::vector<Index> component;       //tree of each vertex (its smallest vertex)
+    std::vector<Index> gap;             //gap[i]: internal node between leaves i and i + 1, -1 between trees
+    std::vector<Weight> height;         //weight of internal node n + i
+    std::vector<Index> edgeId;          //forest edge ID of internal node n + i
+    int levels {0};
+    std::vector<Index> table;           //table[k * (n - 1) + i]: max of gap[i .. i + 2^k - 1]
+
+    //internal node (Kruskal tree ID) at the LCA of connected u != v
+    Index lcaNode(Index u, Index v) const;
+    void buildTable();
+};
+
+#endif      // BOTTLENECK_HPP_
@@ -0,0 +1,127 @@
+#include "clustering.hpp"
+#include "union_find.hpp"
+#include "graph.hpp"
+#include <vector>
+#include <algorithm>
+
+KruskalTree buildKruskalTree(const Graph& F) {
+    Index n = F.numVertices();
+    KruskalTree krt;
+    krt.numLeaves = n;
+    krt.parent.assign(n, -1);
+    krt.left.assign(n, -1);
+    krt.right.assign(n, -1);
+    krt.height.assign(n, WEIGHT_MIN);
+    krt.size.assign(n, 1);
+    krt.edgeId.assign(n, -1);
+
+    std::vector<Graph::Edge> edges;
+    for (Index u = 0; u < n; ++u) {
+        for (auto e : *F.neighbours(u)) {
+            if (u != e.v1) continue;                    //avoid duplicate edge
+            edges.push_back(e);
+        }
+    }
+    std::sort(edges.begin(), edges.end(), lighterEdge);
+
+    UnionFind UF(n);
+    std::vector<Index> top(n);                          //Kruskal tree node of each UF root
+    for (Index v = 0; v < n; ++v) top[v] = v;
+    for (const auto& e : edges) {
+        Index root1 = UF.find(e.v1);
+        Index root2 = UF.find(e.v2);
+        if (root1 == root2) continue;                   //not a forest edge
+        Index node = krt.numNodes();
+        Index a = top[root1];
+        Index b = top[root2];
+        krt.parent.push_back(-1);
+        krt.left.push_back(a);
+        krt.right.push_back(b);
+        krt.height.push_back(e.weight);
+        krt.size.push_back(krt.size[a] + krt.size[b]);
+        krt.edgeId.push_back(e.edgeId);
+        krt.parent[a] = node;
+        krt.parent[b] = node;
+        UF.merge(root1, root2);
+        top[UF.find(root1)] = node;
+    }
+    return krt;
+}
+
+Dendrogram::Dendrogram(const Graph& F) : krt(buildKruskalTree(F)) {
+    Index nodes = krt.numNodes();
+    log = 1;
+    Index p = 1; //p = 2^k
+    while (p <= nodes) {
+        p *= 2;
+        ++log;
+    }
+    //parents have larger IDs, so filling from the top keeps ancestors ready
+    up.assign(nodes, std::vector<Index>(log, -1));
+    for (Index v = nodes - 1; v >= 0; --v) {
+        up[v][0] = krt.parent[v];
+        for (int i = 1; i < log; ++i) {
+            if (up[v][i - 1] == -1) break;
+            up[v][i] = up[up[v][i - 1]][i - 1];
+        }
+    }
+}
+
+const KruskalTree& Dendrogram::tree() const {
+    return krt;
+}
+
+Index Dendrogram::numVertices() const {
+    return krt.numLeaves;
+}
+
+std::vector<Index> Dendrogram::cutClusters(Index k) const {
+    Index n = krt.numLeaves;
+    Index merges = krt.numNodes() - n;
+    //k clusters means keeping the first n - k merges
+    Index keep = std::clamp<Index>(n - k, 0, merges);
+    return labelsBelow(n + keep);
+}
+
+std::vector<Index> Dendrogram::cutThreshold(Weight threshold) const {
+    //heights of internal nodes are sorted, keep all merges with height <= threshold
+    auto firstInternal = krt.height.begin() + krt.numLeaves;
+    auto it = std::upper_bound(firstInternal, krt.height.end(), threshold);
+    return labelsBelow(static_cast<Index>(it - krt.height.begin()));
+}
+
+Index Dendrogram::clusterAt(Index v, Weight threshold) const {
+    //climb while the ancestor still merges at distance <= threshold
+    for (int i = log - 1; i >= 0; --i) {
+        Index a = up[v][i];
+        if (a != -1 && krt.height[a] <= threshold) v = a;
+    }
+    return v;
+}
+
+Index Dendrogram::clusterSize(Index node) const {
+    return krt.size.at(node);
+}
+
+
+//helper functions
+
+std::vector<Index> Dendrogram::labelsBelow(Index limit) const {
+    Index n = krt.numLeaves;
+    //cluster root of every node, from the top down (parents have larger IDs)
+    std::vector<Index> root(limit);
+    for (Index v = limit - 1; v >= 0; --v) {
+        Index p = krt.parent[v];
+        root[v] = (p == -1 || p >= limit) ? v : root[p];
+    }
+    //number clusters by their smallest vertex
+    std::vector<Index> label(n);
+    std::vector<Index> clusterLabel(limit, -1);
+    Index count = 0;
+    for (Index v = 0; v < n; ++v) {
+        Index r = root[v];
+        if (clusterLabel[r] == -1) clusterLabel[r] = count++;
+        label[v] = clusterLabel[r];
+    }
+    return label;
+}
@@ -0,0 +1,60 @@
+#ifndef CLUSTERING_HPP_
+#define CLUSTERING_HPP_
+
+#include "graph.hpp"
+#include <vector>
+
+//Kruskal reconstruction tree of a minimum spanning forest
+//nodes 0..n-1 are the vertices (leaves); every forest edge, taken in increasing weight order,
+//adds an internal node joining the two clusters it connects, with the edge weight as height.
+//node IDs therefore increase towards the roots and heights never decrease along a root path
+struct KruskalTree {
+    Index numLeaves {0};
+    std::vector<Index> parent;      //parent node, -1 for roots
+    std::vector<Index> left;        //first child, -1 for leaves
+    std::vector<Index> right;       //second child, -1 for leaves
+    std::vector<Weight> height;     //merge distance (WEIGHT_MIN for leaves)
+    std::vector<Index> size;        //number of leaves below the node
+    std::vector<Index> edgeId;      //ID of the forest edge that made the node, -1 for leaves
+
+    Index numNodes() const {
+        return static_cast<Index>(parent.size());
+    }
+};
+
+//build the Kruskal reconstruction tree of forest F (e.g. the output of boruvkaMST or kktMST)
+//O(n log n) for sorting the forest edges, merging with UnionFind
+KruskalTree buildKruskalTree(const Graph& F);
+
+//Single-linkage hierarchical clustering built on a minimum spanning forest
+class Dendrogram {
+    public:
+    //default constructor
+    Dendrogram() = default;
+    //build the full dendrogram and the lifting table for threshold queries, O(n log n)
+    explicit Dendrogram(const Graph& F);
+
+    const KruskalTree& tree() const;
+    Index numVertices() const;
+
+    //cluster labels (0..k-1, numbered by smallest vertex) when cutting into k clusters
+    //a forest with c trees can't be cut into fewer than c clusters, k is raised to c then
+    std::vector<Index> cutClusters(Index k) const;
+    //cluster labels when only merges at distance <= threshold are kept
+    std::vector<Index> cutThreshold(Weight threshold) const;
+
+    //node of the Kruskal tree representing v's cluster at the given threshold, O(log n)
+    Index clusterAt(Index v, Weight threshold) const;
+    //number of vertices in the cluster represented by node
+    Index clusterSize(Index node) const;
+
+    private:
+    KruskalTree krt;
+    int log {0};                            //max power of 2
+    std::vector<std::vector<Index>> up;     //up[i][j]: the 2^j-th ancestor of node i
+
+    //labels when only the internal nodes with ID < limit exist
+    std::vector<Index> labelsBelow(Index limit) const;
+};
+
+#endif      // CLUSTERING_HPP_
@@ -0,0 +1,374 @@
+#include "compressed_graph.hpp"
+#include "spanning_forest.hpp"
+#include "union_find.hpp"
+#include "graph.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <numeric>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+
+namespace {
+
+void writeVarint(std::vector<std::uint8_t>& out, std::uint64_t value) {
+    while (value >= 0x80) {
+        out.push_back(static_cast<std::uint8_t>(value | 0x80));
+        value >>= 7;
+    }
+    out.push_back(static_cast<std::uint8_t>(value));
+}
+
+std::uint64_t zigzag(std::int64_t value) {
+    return (static_cast<std::uint64_t>(value) << 1) ^ static_cast<std::uint64_t>(value >> 63);
+}
+
+//(weight, original edge ID) order of lighterEdge; the IDs are only decoded on a weight tie
+bool lighter(const CompressedGraph& G, Weight w1, Index e1, Weight w2, Index e2) {
+    if (w1 != w2) return w1 < w2;
+    if (e1 == e2) return false;
+    Index id1 = G.originalId(e1);
+    Index id2 = G.originalId(e2);
+    if (id1 != id2) return id1 < id2;
+    return e1 < e2;
+}
+
+//forest edges chosen by edge index, turned into a SpanningForest with the original IDs
+struct ChosenEdges {
+    std::vector<Index> edge;
+    std::vector<Index> v1;
+    std::vector<Index> v2;
+
+    void add(Index e, Index u, Index v) {
+        edge.push_back(e);
+        v1.push_back(u);
+        v2.push_back(v);
+    }
+
+    SpanningForest forest(const CompressedGraph& G) const {
+        SpanningForest F(G.numVertices());
+        F.edges.reserve(edge.size());
+        std::vector<Index> ids = G.originalIds(edge);
+        for (std::size_t i = 0; i < edge.size(); ++i) F.add({G.weight(edge[i]), v1[i], v2[i], ids[i]});
+        return F;
+    }
+};
+
+//binary min-heap of vertices keyed by (key[v], via[v]) with decrease-key
+class VertexHeap {
+ public:
+    VertexHeap(const CompressedGraph& G, Index n) : G(G), pos(n, -1), key(n), via(n, -1) {}
+
+    bool empty() const {
+        return heap.empty();
+    }
+    //was v ever given a key?
+    bool seen(Index v) const {
+        return via[v] != -1;
+    }
+    Index edge(Index v) const {
+        return via[v];
+    }
+    //insert v or lower its key, if (w, e) is lighter than the current one
+    void offer(Index v, Weight w, Index e) {
+        if (seen(v) && !lighter(G, w, e, key[v], via[v])) return;
+        key[v] = w;
+        via[v] = e;
+        if (pos[v] == -1) {
+            pos[v] = static_cast<Index>(heap.size());
+            heap.push_back(v);
+        }
+        siftUp(pos[v]);
+    }
+    Index pop() {
+        Index top = heap.front();
+        pos[top] = -1;
+        Index last = heap.back();
+        heap.pop_back();
+        if (!heap.empty()) {
+            heap.front() = last;
+            pos[last] = 0;
+            siftDown(0);
+        }
+        return top;
+    }
+
+ private:
+    const CompressedGraph& G;       //for the original IDs of tied keys
+    std::vector<Index> heap;
+    std::vector<Index> pos;         //position in heap, -1 if not in it
+    std::vector<Weight> key;
+    std::vector<Index> via;         //edge index of the key, -1 if none yet
+
+    bool less(Index a, Index b) const {
+        return lighter(G, key[a], via[a], key[b], via[b]);
+    }
+    void place(Index i, Index v) {
+        heap[i] = v;
+        pos[v] = i;
+    }
+    void siftUp(Index i) {
+        Index v = heap[i];
+        while (i > 0) {
+            Index parent = (i - 1) / 2;
+            if (!less(v, heap[parent])) break;
+            place(i, heap[parent]);
+            i = parent;
+        }
+        place(i, v);
+    }
+    void siftDown(Index i) {
+        Index v = heap[i];
+        Index size = static_cast<Index>(heap.size());
+        while (2 * i + 1 < size) {
+            Index child = 2 * i + 1;
+            if (child + 1 < size && less(heap[child + 1], heap[child])) ++child;
+            if (!less(heap[child], v)) break;
+            place(i, heap[child]);
+            i = child;
+        }
+        place(i, v);
+    }
+};
+
+}  // namespace
+
+CompressedGraph::CompressedGraph(const Graph& G, WeightEncoding weights) : n(G.numVertices()), encoding(weights) {
+    //every edge once as (smaller endpoint, larger endpoint), in edge index order
+    std::vector<Graph::Edge> edges;
+    for (Index u = 0; u < n; ++u) {
+        for (auto e : *G.neighbours(u)) {
+            if (u != e.v1 || e.v1 == e.v2) continue;    //avoid duplicate edge and self-loops
+            if (e.v1 > e.v2) std::swap(e.v1, e.v2);
+            edges.push_back(e);
+        }
+    }
+    std::sort(edges.begin(), edges.end(), [](const Graph::Edge& a, const Graph::Edge& b) {
+        return std::tie(a.v1, a.v2, a.edgeId) < std::tie(b.v1, b.v2, b.edgeId);
+    });
+    m = static_cast<Index>(edges.size());
+
+    //Exact: is every weight an integer (in a 16-bit range), or a float, without loss?
+    double lo = 0;
+    double hi = 0;
+    bool any = false;
+    bool integral = true;
+    bool floatExact = std::is_floating_point_v<Weight> && sizeof(float) < sizeof(Weight);
+    for (const auto& e : edges) {
+        double w = static_cast<double>(e.weight);
+        if (floatExact && std::isfinite(w) && std::abs(w) > std::numeric_limits<float>::max()) floatExact = false;
+        if (floatExact && static_cast<Weight>(static_cast<float>(e.weight)) != e.weight) floatExact = false;
+        if (!std::isfinite(w)) {
+            integral = false;
+            continue;
+        }
+        if (w != std::floor(w) || static_cast<Weight>(w) != e.weight) integral = false;
+        lo = any ? std::min(lo, w) : w;
+        hi = any ? std::max(hi, w) : w;
+        any = true;
+    }
+    switch (encoding) {
+        case WeightEncoding::Float32: storage = WeightStorage::Float; break;
+        case WeightEncoding::Quantized16: storage = WeightStorage::Levels; break;
+        default:
+            if (m > 0 && integral && hi - lo <= 65535) storage = WeightStorage::Levels;
+            else if (m > 0 && floatExact) storage = WeightStorage::Float;
+    }
+
+    switch (storage) {
+        case WeightStorage::Float:
+            floatWeights.reserve(m);
+            for (const auto& e : edges) floatWeights.push_back(static_cast<float>(e.weight));
+            break;
+        case WeightStorage::Levels: {
+            //65536 levels between the extremes, or steps of 1 for exact integers
+            levelBase = lo;
+            levelStep = encoding == WeightEncoding::Quantized16 ? (hi - lo) / 65535 : 1;
+            levels.reserve(m);
+            for (const auto& e : edges) {
+                double level = levelStep > 0 ? std::round((static_cast<double>(e.weight) - lo) / levelStep) : 0;
+                levels.push_back(static_cast<std::uint16_t>(std::clamp(level, 0.0, 65535.0)));  //infinities clamp
+            }
+            break;
+        }
+        default:
+            exactWeights.reserve(m);
+            for (const auto& e : edges) exactWeights.push_back(e.weight);
+    }
+
+    Index previousId = 0;
+    for (Index k = 0; k < m; ++k) {
+        const auto& e = edges[k];
+        if (k % COMPRESSED_ID_BLOCK_EDGES == 0) {
+            idBlockOffset.push_back(ids.size());
+            previousId = 0;                             //decodable without the edges before it
+        }
+        writeVarint(ids, zigzag(static_cast<std::int64_t>(e.edgeId) - previousId));
+        previousId = e.edgeId;
+    }
+    ids.shrink_to_fit();
+
+    //first edge index of every vertex to a larger neighbour, and the edges to smaller
+    //neighbours grouped by their larger endpoint (in index order, so by neighbour)
+    std::vector<Index> first(n + 1, 0);
+    std::vector<Index> backStart(n + 1, 0);
+    for (const auto& e : edges) {
+        ++first[e.v1 + 1];
+        ++backStart[e.v2 + 1];
+    }
+    std::partial_sum(first.begin(), first.end(), first.begin());
+    std::partial_sum(backStart.begin(), backStart.end(), backStart.begin());
+    std::vector<Index> back(m);
+    {
+        std::vector<Index> next(backStart.begin(), backStart.end() - 1);
+        for (Index k = 0; k < m; ++k) back[next[edges[k].v2]++] = k;
+    }
+
+    edgesPerVertex = n == 0 ? 0 : (static_cast<std::int64_t>(m) << 16) / n;
+    adjacency.reserve(2 * static_cast<std::size_t>(m) + n);
+    for (Index u = 0; u < n; ++u) {
+        if (u % COMPRESSED_BLOCK_VERTICES == 0) {
+            blockOffset.push_back(adjacency.size());
+            blockEdge.push_back(first[u]);
+        }
+        writeVarint(adjacency, (backStart[u + 1] - backStart[u]) + (first[u + 1] - first[u]));
+        std::int64_t previous = u;
+        bool leading = true;
+        auto putNeighbour = [&](Index v) {
+            writeVarint(adjacency, leading ? zigzag(v - previous) : static_cast<std::uint64_t>(v - previous));
+            previous = v;
+            leading = false;
+        };
+        //smaller neighbours first: all of them precede u, which precedes the larger ones
+        for (Index i = backStart[u]; i < backStart[u + 1]; ++i) {
+            putNeighbour(edges[back[i]].v1);
+            std::int64_t distance = first[u] - 1 - back[i];
+            writeVarint(adjacency, zigzag(distance - predictedBack(u, edges[back[i]].v1)));
+        }
+        for (Index k = first[u]; k < first[u + 1]; ++k) putNeighbour(edges[k].v2);
+    }
+    adjacency.shrink_to_fit();
+}
+
+Index CompressedGraph::originalId(Index e) const {
+    Index block = e / COMPRESSED_ID_BLOCK_EDGES;
+    const std::uint8_t* p = ids.data() + idBlockOffset[block];
+    std::int64_t id = 0;
+    for (Index k = block * COMPRESSED_ID_BLOCK_EDGES; k <= e; ++k) id += unzigzag(readVarint(p));
+    return static_cast<Index>(id);
+}
+
+std::vector<Index> CompressedGraph::originalIds(const std::vector<Index>& edges) const {
+    std::vector<std::size_t> order(edges.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::sort(order.begin(), order.end(), [&edges](std::size_t a, std::size_t b) { return edges[a] < edges[b]; });
+    std::vector<Index> result(edges.size());
+    const std::uint8_t* p = ids.data();
+    std::int64_t id = 0;
+    Index decoded = -1;                             //edge index of id
+    for (std::size_t i : order) {
+        while (decoded < edges[i]) {
+            ++decoded;
+            if (decoded % COMPRESSED_ID_BLOCK_EDGES == 0) id = 0;
+            id += unzigzag(readVarint(p));
+        }
+        result[i] = static_cast<Index>(id);
+    }
+    return result;
+}
+
+Graph CompressedGraph::toGraph() const {
+    std::vector<Index> all(m);
+    std::iota(all.begin(), all.end(), 0);
+    std::vector<Index> original = originalIds(all);
+    std::vector<Graph::Edge> edges;
+    edges.reserve(m);
+    forEachEdge([&](Index u, Index v, Index e) { edges.push_back({weight(e), u, v, original[e]}); });
+    return Graph(n, std::move(edges));
+}
+
+std::size_t CompressedGraph::memoryBytes() const {
+    return sizeof(CompressedGraph) + adjacency.capacity() + ids.capacity() +
+           blockOffset.capacity() * sizeof(std::uint64_t) + blockEdge.capacity() * sizeof(Index) +
+           idBlockOffset.capacity() * sizeof(std::uint64_t) +
+           exactWeights.capacity() * sizeof(Weight) + floatWeights.capacity() * sizeof(float) +
+           levels.capacity() * sizeof(std::uint16_t);
+}
+
+double CompressedGraph::bytesPerEdge() const {
+    return m == 0 ? 0.0 : static_cast<double>(memoryBytes()) / m;
+}
+
+SpanningForest compressedBoruvkaForest(const CompressedGraph& G) {
+    Index n = G.numVertices();
+    struct Candidate {
+        Weight weight;
+        Index edge;
+        Index v1;
+        Index v2;
+    };
+    UnionFind UF(n);
+    std::vector<Index> comp(n);
+    std::vector<Candidate> cheapest(n);
+    ChosenEdges chosen;
+    while (static_cast<Index>(chosen.edge.size()) < n - 1) {
+        for (Index v = 0; v < n; ++v) {
+            comp[v] = UF.find(v);
+            cheapest[v].edge = -1;
+        }
+        //cheapest edge leaving every component, one pass over the stream
+        G.forEachEdge([&](Index u, Index v, Index e) {
+            Index c1 = comp[u];
+            Index c2 = comp[v];
+            if (c1 == c2) return;
+            Weight w = G.weight(e);
+            for (Index c : {c1, c2}) {
+                if (cheapest[c].edge == -1 || lighter(G, w, e, cheapest[c].weight, cheapest[c].edge)) {
+                    cheapest[c] = {w, e, u, v};
+                }
+            }
+        });
+        bool merged = false;
+        for (Index c = 0; c < n; ++c) {
+            const Candidate& best = cheapest[c];
+            if (best.edge == -1) continue;
+            Index root1 = UF.find(best.v1);
+            Index root2 = UF.find(best.v2);
+            if (root1 == root2) continue;               //chosen by both of its components
+            UF.merge(root1, root2);
+            chosen.add(best.edge, best.v1, best.v2);
+            merged = true;
+        }
+        if (!merged) break;                             //every component is a tree of the forest
+    }
+    return chosen.forest(G);
+}
+
+SpanningForest compressedPrimForest(const CompressedGraph& G) {
+    Index n = G.numVertices();
+    VertexHeap heap(G, n);
+    std::vector<char> inTree(n, 0);
+    std::vector<Index> from(n, -1);                 //tree end of v's key edge
+    ChosenEdges chosen;
+    auto visit = [&](Index u) {
+        inTree[u] = 1;
+        G.forEachNeighbour(u, [&](Index v, Index e) {
+            if (inTree[v]) return;
+            Index before = heap.edge(v);
+            heap.offer(v, G.weight(e), e);
+            if (heap.edge(v) != before) from[v] = u;
+        });
+    };
+    for (Index start = 0; start < n; ++start) {
+        if (inTree[start]) continue;
+        visit(start);
+        while (!heap.empty()) {
+            Index v = heap.pop();
+            chosen.add(heap.edge(v), std::min(from[v], v), std::max(from[v], v));
+            visit(v);
+        }
+    }
+    return chosen.forest(G);
+}
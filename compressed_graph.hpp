@@ -0,0 +1,177 @@
+#ifndef COMPRESSED_GRAPH_HPP_
+#define COMPRESSED_GRAPH_HPP_
+
+#include "graph.hpp"
+#include "spanning_forest.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+//how a CompressedGraph stores its weights; every encoding keeps the order of the weights
+//(a <= b stays decoded(a) <= decoded(b)), so an MST of the decoded weights is found exactly
+enum class WeightEncoding {
+    Exact,          //Weight as is (in 2 or 4 bytes when every weight fits there without loss)
+    Float32,        //rounded to float (4 bytes)
+    Quantized16     //65536 evenly spaced levels between the smallest and largest finite weight (2 bytes)
+};
+
+//vertices per entry of the random access index
+constexpr Index COMPRESSED_BLOCK_VERTICES = 16;
+//edge indices per entry of the original edge ID index
+constexpr Index COMPRESSED_ID_BLOCK_EDGES = 128;
+
+//Read-only undirected graph in a compact byte stream, for graphs that don't fit as a Graph
+//each undirected edge (self-loops are dropped) gets an index 0 .. numEdges() - 1 in the order
+//(smaller endpoint, larger endpoint, edge ID); weights are stored once per edge in that order.
+//vertex u's neighbours are kept sorted as varints: its degree, the first neighbour as a zigzag
+//offset from u, then the gaps to the previous neighbour. an edge to a larger neighbour has the
+//next index after u's previous one, an edge to a smaller neighbour v < u is followed by a varint
+//pointing back to its index (relative to a guess from the average density). original edge IDs
+//are zigzag deltas in index order (from 0 at every COMPRESSED_ID_BLOCK_EDGES-th edge), read
+//when a result is handed out or two weights tie.
+//with a locality-preserving vertex order (reorderGraph) most varints take one or two bytes:
+//the road-like grid of the compressed bench needs about 7.5 bytes per edge besides the weights,
+//so with random double weights Exact takes 15.6, Float32 11.6 and Quantized16 9.6; exact weights
+//get under 10 only when they fit in 16 bits (e.g. integer travel times), which Exact then uses
+class CompressedGraph {
+ public:
+    CompressedGraph() = default;
+    explicit CompressedGraph(const Graph& G, WeightEncoding encoding = WeightEncoding::Exact);
+
+    Index numVertices() const {
+        return n;
+    }
+    //undirected edges, self-loops not counted
+    Index numEdges() const {
+        return m;
+    }
+    WeightEncoding weightEncoding() const {
+        return encoding;
+    }
+
+    //decoded weight of edge index e
+    Weight weight(Index e) const {
+        switch (storage) {
+            case WeightStorage::Float: return static_cast<Weight>(floatWeights[e]);
+            case WeightStorage::Levels: return static_cast<Weight>(levelBase + levelStep * levels[e]);
+            default: return exactWeights[e];
+        }
+    }
+
+    //call f(neighbour, edge index) for every neighbour of v, neighbours in increasing order
+    //finds v's list from the nearest index entry (at most COMPRESSED_BLOCK_VERTICES - 1 lists skipped)
+    template <typename F>
+    void forEachNeighbour(Index v, F&& f) const {
+        Index block = v / COMPRESSED_BLOCK_VERTICES;
+        const std::uint8_t* p = adjacency.data() + blockOffset[block];
+        Index edge = blockEdge[block];
+        for (Index u = block * COMPRESSED_BLOCK_VERTICES; u < v; ++u) {
+            p = decodeList(u, p, edge, [](Index, Index) {});
+        }
+        decodeList(v, p, edge, f);
+    }
+
+    //call f(u, v, edge index) for every edge once, u < v, in edge index order: one pass over the stream
+    template <typename F>
+    void forEachEdge(F&& f) const {
+        const std::uint8_t* p = adjacency.data();
+        Index edge = 0;
+        for (Index u = 0; u < n; ++u) {
+            Index first = edge;
+            p = decodeList(u, p, edge, [&f, u, first](Index v, Index e) {
+                if (e >= first) f(u, v, e);
+            });
+        }
+    }
+
+    //original edge ID of edge index e (at most COMPRESSED_ID_BLOCK_EDGES deltas decoded)
+    Index originalId(Index e) const;
+    //original edge IDs of the given edge indices (one pass over the ID stream)
+    std::vector<Index> originalIds(const std::vector<Index>& edges) const;
+    //the decompressed graph (decoded weights, original edge IDs)
+    Graph toGraph() const;
+    //approximate footprint in bytes
+    std::size_t memoryBytes() const;
+    //memoryBytes() per undirected edge
+    double bytesPerEdge() const;
+
+ private:
+    //the array holding the weights: Float32 uses Float, Quantized16 Levels, and Exact the
+    //narrowest of Levels (integers at most 65535 apart, step 1), Float and Full that loses nothing
+    enum class WeightStorage { Full, Float, Levels };
+
+    Index n {0};
+    Index m {0};
+    WeightEncoding encoding {WeightEncoding::Exact};
+    WeightStorage storage {WeightStorage::Full};
+    std::vector<std::uint8_t> adjacency;        //neighbour lists of all vertices, in vertex order
+    std::vector<std::uint64_t> blockOffset;     //byte offset of the list of every COMPRESSED_BLOCK_VERTICES-th vertex
+    std::vector<Index> blockEdge;               //index of that vertex's first edge to a larger neighbour
+    std::vector<Weight> exactWeights;
+    std::vector<float> floatWeights;
+    std::vector<std::uint16_t> levels;
+    double levelBase {0};                       //Levels: weight of level 0
+    double levelStep {0};                       //Levels: weight difference of adjacent levels
+    std::vector<std::uint8_t> ids;              //zigzag deltas of the original edge IDs
+    std::vector<std::uint64_t> idBlockOffset;   //byte offset of the ID of every COMPRESSED_ID_BLOCK_EDGES-th edge
+    std::int64_t edgesPerVertex {0};            //m / n in 16.16 fixed point
+
+    //guess of how many edge indices lie between an edge (v, u), v < u, and u's first edge
+    //to a larger neighbour: (u - v) times the average number of such edges per vertex
+    std::int64_t predictedBack(std::int64_t u, std::int64_t v) const {
+        return ((u - v) * edgesPerVertex >> 16) - 1;
+    }
+
+    static std::uint64_t readVarint(const std::uint8_t*& p) {
+        std::uint64_t value = *p++;
+        if (value < 0x80) return value;             //most gaps fit in one byte
+        value &= 0x7F;
+        for (int shift = 7;; shift += 7) {
+            std::uint64_t byte = *p++;
+            value |= (byte & 0x7F) << shift;
+            if (byte < 0x80) return value;
+        }
+    }
+
+    static std::int64_t unzigzag(std::uint64_t value) {
+        return static_cast<std::int64_t>(value >> 1) ^ -static_cast<std::int64_t>(value & 1);
+    }
+
+    //decode u's list starting at p: f(neighbour, edge index) per entry; edge is u's first edge
+    //to a larger neighbour and is advanced past u's edges. returns the start of the next list
+    template <typename F>
+    const std::uint8_t* decodeList(Index u, const std::uint8_t* p, Index& edge, F&& f) const {
+        Index degree = static_cast<Index>(readVarint(p));
+        Index next = edge;
+        std::int64_t v = u;
+        for (Index i = 0; i < degree; ++i) {
+            std::uint64_t gap = readVarint(p);
+            if (i == 0) {
+                v += unzigzag(gap);
+            }
+            else {
+                v += static_cast<std::int64_t>(gap);
+            }
+            if (v < u) {
+                std::int64_t back = predictedBack(u, v) + unzigzag(readVarint(p));
+                f(static_cast<Index>(v), edge - 1 - static_cast<Index>(back));
+            }
+            else {
+                f(static_cast<Index>(v), next++);
+            }
+        }
+        edge = next;
+        return p;
+    }
+};
+
+//Boruvka on a CompressedGraph: every round is one sequential pass over the stream, so only
+//O(n) words are allocated besides the forest. edges are compared by (decoded weight, original
+//edge ID) as lighterEdge does, so with Exact weights the forest is the one of every other engine,
+//ties included
+SpanningForest compressedBoruvkaForest(const CompressedGraph& G);
+//Prim with an indexed binary heap (O(n) extra memory), one tree after another;
+//same order of edges, so the same forest as compressedBoruvkaForest
+SpanningForest compressedPrimForest(const CompressedGraph& G);
+
+#endif      // COMPRESSED_GRAPH_HPP_
@@ -0,0 +1,210 @@
+#include "dynamic_mst.hpp"
+#include "boruvka.hpp"
+#include "graph.hpp"
+#include <vector>
+#include <algorithm>
+
+DynamicMST::DynamicMST(Index n) : n(n), treeAdj(n), mark(n, 0), predEdge(n, -1) {}
+
+DynamicMST::DynamicMST(const Graph& G) : DynamicMST(G.numVertices()) {
+    for (Index u = 0; u < n; ++u) {
+        for (auto e : *G.neighbours(u)) {
+            if (u != e.v1) continue;                    //avoid duplicate edge
+            addEdgeSlot(e);
+        }
+    }
+    //initial forest from a static engine
+    Graph mst = boruvkaMST(G);
+    for (Index u = 0; u < n; ++u) {
+        for (auto e : *mst.neighbours(u)) {
+            if (u != e.v1) continue;
+            link(e.edgeId);
+        }
+    }
+}
+
+Index DynamicMST::insertEdge(Index u, Index v, Weight weight) {
+    if (u < 0 || v < 0 || u >= n || v >= n) return -1;
+    Index id = addEdgeSlot({weight, u, v, static_cast<Index>(edges.size())});
+    offer(id);
+    return id;
+}
+
+void DynamicMST::deleteEdge(Index edgeId) {
+    if (!hasEdge(edgeId)) return;
+    alive[edgeId] = false;
+    if (!inTree[edgeId]) return;                        //non-tree edge: forest unchanged
+    cut(edgeId);
+    reconnect(edges[edgeId].v1);
+}
+
+void DynamicMST::updateWeight(Index edgeId, Weight weight) {
+    if (!hasEdge(edgeId)) return;
+    Graph::Edge& e = edges[edgeId];
+    Weight old = e.weight;
+    if (inTree[edgeId]) {
+        weightSum += static_cast<WeightSum>(weight) - old;      //in WeightSum: no round-off or overflow in Weight
+        e.weight = weight;
+        //a tree edge getting lighter stays in the forest
+        if (weight <= old) return;
+        //heavier: cut it and let the lightest crossing edge (possibly itself) back in
+        cut(edgeId);
+        reconnect(e.v1);
+    }
+    else {
+        e.weight = weight;
+        //a non-tree edge getting heavier stays out of the forest
+        if (weight >= old) return;
+        offer(edgeId);
+    }
+}
+
+WeightSum DynamicMST::totalWeight() const {
+    return weightSum;
+}
+
+bool DynamicMST::inForest(Index edgeId) const {
+    return hasEdge(edgeId) && inTree[edgeId];
+}
+
+bool DynamicMST::hasEdge(Index edgeId) const {
+    return edgeId >= 0 && edgeId < static_cast<Index>(alive.size()) && alive[edgeId];
+}
+
+Index DynamicMST::numVertices() const {
+    return n;
+}
+
+Index DynamicMST::numForestEdges() const {
+    return treeEdges;
+}
+
+Graph DynamicMST::forest() const {
+    Graph F(n);
+    for (std::size_t id = 0; id < edges.size(); ++id) {
+        if (alive[id] && inTree[id]) F.addEdge(edges[id]);
+    }
+    return F;
+}
+
+Graph DynamicMST::graph() const {
+    std::vector<Graph::Edge> live;
+    for (std::size_t id = 0; id < edges.size(); ++id) {
+        if (alive[id]) live.push_back(edges[id]);
+    }
+    return Graph(n, std::move(live));
+}
+
+
+//helper functions
+
+Index DynamicMST::addEdgeSlot(Graph::Edge e) {
+    Index id = e.edgeId;
+    if (id >= static_cast<Index>(edges.size())) {
+        edges.resize(id + 1);
+        alive.resize(id + 1, false);
+        inTree.resize(id + 1, false);
+    }
+    edges[id] = e;
+    alive[id] = true;
+    inTree[id] = false;
+    return id;
+}
+
+void DynamicMST::link(Index edgeId) {
+    const Graph::Edge& e = edges[edgeId];
+    treeAdj[e.v1].push_back(edgeId);
+    treeAdj[e.v2].push_back(edgeId);
+    inTree[edgeId] = true;
+    weightSum += e.weight;
+    ++treeEdges;
+}
+
+void DynamicMST::cut(Index edgeId) {
+    const Graph::Edge& e = edges[edgeId];
+    for (Index x : {e.v1, e.v2}) {
+        auto& adj = treeAdj[x];
+        auto it = std::find(adj.begin(), adj.end(), edgeId);
+        *it = adj.back();
+        adj.pop_back();
+    }
+    inTree[edgeId] = false;
+    weightSum -= e.weight;
+    --treeEdges;
+}
+
+Index DynamicMST::pathMax(Index u, Index v) {
+    //iterative DFS from u over the forest, remember the edge used to reach each vertex
+    ++stamp;
+    std::vector<Index> stack {u};
+    mark[u] = stamp;
+    bool found = (u == v);
+    while (!stack.empty() && !found) {
+        Index x = stack.back();
+        stack.pop_back();
+        for (Index id : treeAdj[x]) {
+            const Graph::Edge& e = edges[id];
+            Index y = (e.v1 == x) ? e.v2 : e.v1;
+            if (mark[y] == stamp) continue;
+            mark[y] = stamp;
+            predEdge[y] = id;
+            if (y == v) {
+                found = true;
+                break;
+            }
+            stack.push_back(y);
+        }
+    }
+    if (!found) return -1;
+    //walk back from v to u and keep the heaviest edge
+    Index best = -1;
+    for (Index x = v; x != u; ) {
+        Index id = predEdge[x];
+        if (best == -1 || lighterEdge(edges[best], edges[id])) best = id;
+        x = (edges[id].v1 == x) ? edges[id].v2 : edges[id].v1;
+    }
+    return best;
+}
+
+void DynamicMST::markTree(Index u) {
+    ++stamp;
+    std::vector<Index> stack {u};
+    mark[u] = stamp;
+    while (!stack.empty()) {
+        Index x = stack.back();
+        stack.pop_back();
+        for (Index id : treeAdj[x]) {
+            const Graph::Edge& e = edges[id];
+            Index y = (e.v1 == x) ? e.v2 : e.v1;
+            if (mark[y] == stamp) continue;
+            mark[y] = stamp;
+            stack.push_back(y);
+        }
+    }
+}
+
+void DynamicMST::reconnect(Index u) {
+    markTree(u);
+    //lightest live non-tree edge with exactly one endpoint on u's side
+    Index best = -1;
+    for (std::size_t id = 0; id < edges.size(); ++id) {
+        if (!alive[id] || inTree[id]) continue;
+        const Graph::Edge& e = edges[id];
+        if ((mark[e.v1] == stamp) == (mark[e.v2] == stamp)) continue;
+        if (best == -1 || lighterEdge(e, edges[best])) best = static_cast<Index>(id);
+    }
+    if (best != -1) link(best);
+}
+
+void DynamicMST::offer(Index edgeId) {
+    const Graph::Edge& e = edges[edgeId];
+    if (e.v1 == e.v2) return;                           //self-loop never enters the forest
+    Index heaviest = pathMax(e.v1, e.v2);
+    if (heaviest == -1) {                               //different trees: join them
+        link(edgeId);
+    }
+    else if (lighterEdge(e, edges[heaviest])) {         //cycle property: swap out heaviest edge
+        cut(heaviest);
+        link(edgeId);
+    }
+}
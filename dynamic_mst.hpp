@@ -0,0 +1,68 @@
+#ifndef DYNAMIC_MST_HPP_
+#define DYNAMIC_MST_HPP_
+
+#include "graph.hpp"
+#include <vector>
+
+//Fully dynamic minimum spanning forest (recompute-on-cut design)
+//the forest is kept explicitly; an update only touches the tree(s) it affects
+//insertEdge: O(n) to find the heaviest edge on the tree path
+//deleteEdge: O(1) for non-tree edges, O(n + m) for tree edges (replacement search across the cut)
+//updateWeight: O(1) when the edge keeps its role, otherwise same as delete/insert
+//totalWeight and inForest: O(1)
+class DynamicMST {
+    public:
+    //start with n isolated vertices
+    explicit DynamicMST(Index n);
+    //start from graph G, the edge IDs of G are kept
+    explicit DynamicMST(const Graph& G);
+
+    //insert edge {u, v} and return its edge ID
+    Index insertEdge(Index u, Index v, Weight weight);
+    //remove edge with the given ID
+    void deleteEdge(Index edgeId);
+    //change the weight of the edge with the given ID
+    void updateWeight(Index edgeId, Weight weight);
+
+    //total weight of the current minimum spanning forest
+    WeightSum totalWeight() const;
+    //is the edge part of the current minimum spanning forest?
+    bool inForest(Index edgeId) const;
+    //does the edge currently exist?
+    bool hasEdge(Index edgeId) const;
+
+    Index numVertices() const;
+    Index numForestEdges() const;
+
+    //current minimum spanning forest
+    Graph forest() const;
+    //current graph (all live edges)
+    Graph graph() const;
+
+    private:
+    Index n;
+    std::vector<Graph::Edge> edges;             //edges[id]: edge with that ID
+    std::vector<bool> alive;                    //alive[id]: edge exists
+    std::vector<bool> inTree;                   //inTree[id]: edge is in the forest
+    std::vector<std::vector<Index>> treeAdj;    //edge IDs of forest edges around each vertex
+    std::vector<int> mark;                      //visit stamps used by traversals
+    std::vector<Index> predEdge;                //edge used to reach each vertex in pathMax
+    int stamp {0};
+    WeightSum weightSum {0};
+    Index treeEdges {0};
+
+    //helper functions
+    Index addEdgeSlot(Graph::Edge e);
+    void link(Index edgeId);
+    void cut(Index edgeId);
+    //ID of heaviest forest edge on the path u -> v, -1 if u and v are not connected
+    Index pathMax(Index u, Index v);
+    //mark all vertices in the tree containing u with a fresh stamp
+    void markTree(Index u);
+    //after cutting a tree edge, reconnect both sides with the lightest crossing edge (if any)
+    void reconnect(Index u);
+    //try to put non-tree edge into the forest (swap with heaviest path edge if lighter)
+    void offer(Index edgeId);
+};
+
+#endif      // DYNAMIC_MST_HPP_
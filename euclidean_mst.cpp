@@ -0,0 +1,250 @@
+#include "euclidean_mst.hpp"
+#include "union_find.hpp"
+#include "graph.hpp"
+#include "thread_pool.hpp"
+#include <array>
+#include <vector>
+#include <algorithm>
+#include <numeric>
+#include <limits>
+#include <cmath>
+
+namespace {
+
+const double INF = std::numeric_limits<double>::infinity();
+
+//max number of points in a leaf of the k-d tree
+constexpr int LEAF_SIZE = 16;
+
+//candidate edge between two points, ordered by (squared distance, smaller point, larger point)
+//so every component has a unique cheapest edge, no matter in which order points are searched
+struct Candidate {
+    double dist2 {INF};
+    Index a {-1};
+    Index b {-1};
+
+    bool operator<(const Candidate& other) const {
+        if (dist2 != other.dist2) return dist2 < other.dist2;
+        if (a != other.a) return a < other.a;
+        return b < other.b;
+    }
+};
+
+//k-d tree over a flat coordinate array (dim coordinates per point)
+class KdTree {
+    public:
+    KdTree(const std::vector<double>& coords, int dim) : coords(coords), dim(dim) {
+        Index n = static_cast<Index>(coords.size()) / dim;
+        order.resize(n);
+        std::iota(order.begin(), order.end(), 0);
+        if (n > 0) build(0, n);
+    }
+
+    Index numNodes() const {
+        return static_cast<Index>(nodes.size());
+    }
+
+    //points in tree order (points of a leaf are contiguous)
+    const std::vector<Index>& points() const {
+        return order;
+    }
+
+    //label every node with the component all of its points belong to, -1 if mixed
+    void labelNodes(const std::vector<Index>& comp) {
+        nodeComp.assign(nodes.size(), -1);
+        //children are created after their parent, so going backwards visits children first
+        for (Index i = numNodes() - 1; i >= 0; --i) {
+            const Node& node = nodes[i];
+            if (node.left == -1) {
+                Index c = comp[order[node.lo]];
+                for (Index k = node.lo + 1; k < node.hi && c != -1; ++k) {
+                    if (comp[order[k]] != c) c = -1;
+                }
+                nodeComp[i] = c;
+            }
+            else {
+                Index c = nodeComp[node.left];
+                nodeComp[i] = (c == nodeComp[node.right]) ? c : -1;
+            }
+        }
+    }
+
+    //nearest point to p outside component c, only improving on best
+    void nearestOutside(Index p, Index c, const std::vector<Index>& comp, Candidate& best) const {
+        search(0, p, c, comp, best);
+    }
+
+    private:
+    struct Node {
+        Index lo, hi;           //range in order
+        Index left {-1};
+        Index right {-1};
+    };
+    const std::vector<double>& coords;
+    int dim;
+    std::vector<Index> order;
+    std::vector<Node> nodes;
+    std::vector<double> boxMin;     //bounding box of node i: [i * dim, (i + 1) * dim)
+    std::vector<double> boxMax;
+    std::vector<Index> nodeComp;
+
+    double coord(Index p, int d) const {
+        return coords[static_cast<std::size_t>(p) * dim + d];
+    }
+
+    Index build(Index lo, Index hi) {
+        Index id = numNodes();
+        nodes.push_back({lo, hi});
+        boxMin.insert(boxMin.end(), dim, INF);
+        boxMax.insert(boxMax.end(), dim, -INF);
+        for (Index k = lo; k < hi; ++k) {
+            for (int d = 0; d < dim; ++d) {
+                boxMin[id * dim + d] = std::min(boxMin[id * dim + d], coord(order[k], d));
+                boxMax[id * dim + d] = std::max(boxMax[id * dim + d], coord(order[k], d));
+            }
+        }
+        if (hi - lo <= LEAF_SIZE) return id;
+        //split at the median of the widest dimension
+        int split = 0;
+        for (int d = 1; d < dim; ++d) {
+            if (boxMax[id * dim + d] - boxMin[id * dim + d] >
+                boxMax[id * dim + split] - boxMin[id * dim + split]) split = d;
+        }
+        Index mid = lo + (hi - lo) / 2;
+        std::nth_element(order.begin() + lo, order.begin() + mid, order.begin() + hi,
+                         [this, split](Index a, Index b) { return coord(a, split) < coord(b, split); });
+        Index left = build(lo, mid);
+        Index right = build(mid, hi);
+        nodes[id].left = left;
+        nodes[id].right = right;
+        return id;
+    }
+
+    //squared distance from point p to the bounding box of node
+    double boxDist2(Index node, Index p) const {
+        double sum = 0.0;
+        for (int d = 0; d < dim; ++d) {
+            double x = coord(p, d);
+            double gap = std::max({0.0, boxMin[node * dim + d] - x, x - boxMax[node * dim + d]});
+            sum += gap * gap;
+        }
+        return sum;
+    }
+
+    void search(Index node, Index p, Index c, const std::vector<Index>& comp, Candidate& best) const {
+        if (nodeComp[node] == c) return;                    //whole subtree inside p's component
+        if (boxDist2(node, p) > best.dist2) return;         //(equal distances kept for tie-breaking)
+        const Node& nd = nodes[node];
+        if (nd.left == -1) {
+            for (Index k = nd.lo; k < nd.hi; ++k) {
+                Index q = order[k];
+                if (comp[q] == c) continue;
+                double sum = 0.0;
+                for (int d = 0; d < dim; ++d) {
+                    double diff = coord(p, d) - coord(q, d);
+                    sum += diff * diff;
+                }
+                Candidate cand {sum, std::min(p, q), std::max(p, q)};
+                if (cand < best) best = cand;
+            }
+            return;
+        }
+        //visit the nearer child first to shrink the bound early
+        Index first = nd.left;
+        Index second = nd.right;
+        if (boxDist2(second, p) < boxDist2(first, p)) std::swap(first, second);
+        search(first, p, c, comp, best);
+        search(second, p, c, comp, best);
+    }
+};
+
+Graph euclideanMSTFlat(const std::vector<double>& coords, int dim, int numThreads) {
+    Index n = static_cast<Index>(coords.size()) / dim;
+    Graph mst(n);
+    if (n <= 1) return mst;
+    ThreadPool& pool = globalThreadPool();
+    if (numThreads <= 0) numThreads = pool.numThreads();
+    numThreads = static_cast<int>(std::min<Index>(numThreads, n));
+
+    KdTree tree(coords, dim);
+    const std::vector<Index>& points = tree.points();
+    UnionFind UF(n);
+    std::vector<Index> comp(n);
+    //cheapest candidate per component; each thread keeps candidates only for the components
+    //its slice of points touches (sorted labels in touched[t], their candidates in local[t]),
+    //so the tables stay O(n) in total whatever the number of threads
+    std::vector<Candidate> cheapest(n);
+    std::vector<std::vector<Index>> touched(numThreads);
+    std::vector<std::vector<Candidate>> local(numThreads);
+
+    while (UF.numberOfComponents() > 1) {
+        for (Index v = 0; v < n; ++v) comp[v] = UF.find(v);      //flatten labels once per round
+        tree.labelNodes(comp);
+
+        //each thread handles a contiguous slice of points in tree order
+        auto worker = [&](int t) {
+            Index lo = static_cast<Index>(static_cast<long long>(n) * t / numThreads);
+            Index hi = static_cast<Index>(static_cast<long long>(n) * (t + 1) / numThreads);
+            std::vector<Index>& comps = touched[t];
+            comps.clear();
+            for (Index k = lo; k < hi; ++k) {
+                Index c = comp[points[k]];
+                if (comps.empty() || comps.back() != c) comps.push_back(c);    //runs once each
+            }
+            std::sort(comps.begin(), comps.end());
+            comps.erase(std::unique(comps.begin(), comps.end()), comps.end());
+            std::vector<Candidate>& best = local[t];
+            best.assign(comps.size(), Candidate {});
+            //neighbouring points in tree order mostly share a component: look up only on a change
+            Index slotComp = -1;
+            std::size_t slot = 0;
+            for (Index k = lo; k < hi; ++k) {
+                Index p = points[k];
+                if (comp[p] != slotComp) {
+                    slotComp = comp[p];
+                    slot = std::lower_bound(comps.begin(), comps.end(), slotComp) - comps.begin();
+                }
+                //the component's best so far bounds the search
+                tree.nearestOutside(p, slotComp, comp, best[slot]);
+            }
+        };
+        pool.parallelParts(numThreads, worker);
+
+        //reduce per-thread candidates and merge the components
+        for (int t = 0; t < numThreads; ++t) {
+            for (std::size_t i = 0; i < touched[t].size(); ++i) {
+                Candidate& best = cheapest[touched[t][i]];
+                if (local[t][i] < best) best = local[t][i];
+            }
+        }
+        Index mergedCount = 0;
+        for (Index v = 0; v < n; ++v) {
+            if (comp[v] != v) continue;
+            Candidate best = cheapest[v];
+            cheapest[v] = Candidate {};                         //ready for the next round
+            if (best.a == -1) continue;
+            if (UF.sameSet(best.a, best.b)) continue;           //both components picked the same edge
+            UF.merge(best.a, best.b);
+            mst.addEdge({static_cast<Weight>(std::sqrt(best.dist2)), best.a, best.b});
+            ++mergedCount;
+        }
+        if (mergedCount == 0) break;
+    }
+    return mst;
+}
+
+}  // namespace
+
+Graph euclideanMST(const std::vector<std::array<double, 2>>& points, int numThreads) {
+    std::vector<double> coords;
+    coords.reserve(points.size() * 2);
+    for (const auto& p : points) coords.insert(coords.end(), p.begin(), p.end());
+    return euclideanMSTFlat(coords, 2, numThreads);
+}
+
+Graph euclideanMST(const std::vector<std::array<double, 3>>& points, int numThreads) {
+    std::vector<double> coords;
+    coords.reserve(points.size() * 3);
+    for (const auto& p : points) coords.insert(coords.end(), p.begin(), p.end());
+    return euclideanMSTFlat(coords, 3, numThreads);
+}
@@ -0,0 +1,16 @@
+#ifndef EUCLIDEAN_MST_HPP_
+#define EUCLIDEAN_MST_HPP_
+
+#include "graph.hpp"
+#include <array>
+#include <vector>
+
+//Euclidean MST directly from a point set (vertex i is points[i], weights are distances)
+//Borůvka over a k-d tree: every round each point searches the nearest point outside its own
+//component, pruning subtrees that lie entirely inside the component or beyond the current bound.
+//No O(n^2) candidate edge set is ever built. Queries are split into numThreads parts run on
+//globalThreadPool() (0: one per pool thread); the result does not depend on the number of parts.
+Graph euclideanMST(const std::vector<std::array<double, 2>>& points, int numThreads = 0);
+Graph euclideanMST(const std::vector<std::array<double, 3>>& points, int numThreads = 0);
+
+#endif      // EUCLIDEAN_MST_HPP_
@@ -0,0 +1,221 @@
+#include "external_mst.hpp"
+#include "union_find.hpp"
+#include "forest_components.hpp"
+#include "graph.hpp"
+#include <vector>
+#include <string>
+#include <fstream>
+#include <iostream>
+#include <filesystem>
+#include <algorithm>
+#include <queue>
+#include <memory>
+#include <random>
+#include <stdexcept>
+#include <cstdio>
+
+namespace {
+
+//smallest read buffer (in edges) given to a run while merging
+constexpr std::size_t MIN_RUN_BUFFER = 1024;
+
+//attempts at a fresh run file name before giving up
+constexpr int RUN_NAME_ATTEMPTS = 100;
+
+//sorted run of edges stored in a binary temp file
+//the file is created exclusively under a random name (one engine per thread, so concurrent
+//external runs neither race on it nor take each other's files), retrying on a collision
+class RunFile {
+    public:
+    explicit RunFile(const std::filesystem::path& dir) {
+        thread_local std::mt19937_64 mt {std::random_device{}()};
+        for (int attempt = 0; attempt < RUN_NAME_ATTEMPTS; ++attempt) {
+            std::filesystem::path candidate = dir / ("mst_run_" + std::to_string(mt()) + ".bin");
+            if (std::FILE* file = std::fopen(candidate.string().c_str(), "wbx")) {
+                std::fclose(file);
+                path = std::move(candidate);
+                return;
+            }
+        }
+        throw std::runtime_error("could not create a run file in " + dir.string());
+    }
+    RunFile(const RunFile&) = delete;
+    RunFile& operator=(const RunFile&) = delete;
+    ~RunFile() {
+        std::error_code ec;
+        std::filesystem::remove(path, ec);
+    }
+    std::filesystem::path path;
+};
+
+void writeRun(const RunFile& run, const std::vector<Graph::Edge>& edges) {
+    std::ofstream out {run.path, std::ios::binary};
+    out.write(reinterpret_cast<const char*>(edges.data()),
+              static_cast<std::streamsize>(edges.size() * sizeof(Graph::Edge)));
+    if (!out) throw std::runtime_error("could not write " + run.path.string());
+}
+
+//buffered sequential reader over one run
+class RunReader {
+    public:
+    RunReader(const RunFile& run, std::size_t bufferEdges)
+        : in {run.path, std::ios::binary}, buf(bufferEdges) {
+        if (!in) throw std::runtime_error("could not read " + run.path.string());
+        refill();
+    }
+    bool empty() const {
+        return pos == size;
+    }
+    const Graph::Edge& front() const {
+        return buf[pos];
+    }
+    void pop() {
+        if (++pos == size) refill();
+    }
+
+    private:
+    std::ifstream in;
+    std::vector<Graph::Edge> buf;
+    std::size_t pos {0};
+    std::size_t size {0};
+
+    void refill() {
+        in.read(reinterpret_cast<char*>(buf.data()),
+                static_cast<std::streamsize>(buf.size() * sizeof(Graph::Edge)));
+        size = static_cast<std::size_t>(in.gcount()) / sizeof(Graph::Edge);
+        pos = 0;
+    }
+};
+
+//merge the runs in sorted order and hand every edge to visit (stops when visit returns false)
+template <typename Visit>
+void mergeRuns(const std::vector<std::unique_ptr<RunFile>>& runs, std::size_t bufferEdges, Visit visit) {
+    std::vector<std::unique_ptr<RunReader>> readers;
+    for (const auto& run : runs) {
+        readers.push_back(std::make_unique<RunReader>(*run, bufferEdges));
+    }
+    auto cmp = [&readers](int a, int b) {
+        return lighterEdge(readers[b]->front(), readers[a]->front());
+    };
+    std::priority_queue<int, std::vector<int>, decltype(cmp)> heap(cmp);
+    for (int i = 0; i < static_cast<int>(readers.size()); ++i) {
+        if (!readers[i]->empty()) heap.push(i);
+    }
+    while (!heap.empty()) {
+        int i = heap.top();
+        heap.pop();
+        if (!visit(readers[i]->front())) return;
+        readers[i]->pop();
+        if (!readers[i]->empty()) heap.push(i);
+    }
+}
+
+//semi-external Kruskal, fills components (if given) from Kruskal's UnionFind
+Graph externalForest(const std::string& inputFile, const ExternalOptions& options,
+                     ForestComponents* components) {
+    std::ifstream infile {inputFile};
+    if (!infile) {
+        std::cerr << inputFile << " could not be opened\n";
+        if (components) *components = {};
+        return Graph();
+    }
+    std::filesystem::path dir = options.tempDir.empty() ? std::filesystem::temp_directory_path()
+                                                        : std::filesystem::path(options.tempDir);
+    //edges held in memory at once (sort buffer, later split between merge readers)
+    std::size_t budgetEdges = std::max<std::size_t>(options.memoryBudget / sizeof(Graph::Edge),
+                                                    2 * MIN_RUN_BUFFER);
+
+    // first line has number of vertices N
+    Index n {};
+    infile >> n;
+    Graph mst(n);
+    UnionFind UF(n);
+    Index forestEdges = 0;
+    //Kruskal step, returns false once the spanning tree is complete
+    auto kruskal = [&](const Graph::Edge& e) {
+        if (!UF.sameSet(e.v1, e.v2)) {
+            UF.merge(e.v1, e.v2);
+            mst.addEdge(e);
+            ++forestEdges;
+        }
+        return forestEdges < n - 1;
+    };
+
+    //phase 1: read chunks, sort them and write sorted runs
+    std::vector<std::unique_ptr<RunFile>> runs;
+    std::vector<Graph::Edge> chunk;
+    chunk.reserve(budgetEdges);
+    Index nextEdgeId = 0;
+    Index i {};
+    Index j {};
+    Weight weight {};
+    while (infile >> i >> j >> weight) {
+        //same validity rule as Graph::addEdge, invalid edges get no ID
+        if (i < 0 || j < 0 || i >= n || j >= n) continue;
+        chunk.push_back({weight, i, j, nextEdgeId++});
+        if (chunk.size() == budgetEdges) {
+            std::sort(chunk.begin(), chunk.end(), lighterEdge);
+            runs.push_back(std::make_unique<RunFile>(dir));
+            writeRun(*runs.back(), chunk);
+            chunk.clear();
+        }
+    }
+    std::sort(chunk.begin(), chunk.end(), lighterEdge);
+    if (runs.empty()) {
+        //everything fit in memory, no need to touch the disk
+        for (const auto& e : chunk) {
+            if (!kruskal(e)) break;
+        }
+        if (components) *components = forestComponents(mst, UF);
+        return mst;
+    }
+    if (!chunk.empty()) {
+        runs.push_back(std::make_unique<RunFile>(dir));
+        writeRun(*runs.back(), chunk);
+    }
+    chunk = {};
+
+    //phase 2: reduce the number of runs until each reader gets a reasonable buffer
+    std::size_t fanIn = std::max<std::size_t>(2, budgetEdges / MIN_RUN_BUFFER - 1);
+    while (runs.size() > fanIn) {
+        std::vector<std::unique_ptr<RunFile>> merged;
+        for (std::size_t first = 0; first < runs.size(); first += fanIn) {
+            std::size_t last = std::min(runs.size(), first + fanIn);
+            std::vector<std::unique_ptr<RunFile>> group;
+            for (std::size_t r = first; r < last; ++r) group.push_back(std::move(runs[r]));
+            merged.push_back(std::make_unique<RunFile>(dir));
+            std::ofstream out {merged.back()->path, std::ios::binary};
+            std::vector<Graph::Edge> outBuf;
+            outBuf.reserve(MIN_RUN_BUFFER);
+            auto flush = [&]() {
+                out.write(reinterpret_cast<const char*>(outBuf.data()),
+                          static_cast<std::streamsize>(outBuf.size() * sizeof(Graph::Edge)));
+                outBuf.clear();
+            };
+            mergeRuns(group, budgetEdges / (group.size() + 1), [&](const Graph::Edge& e) {
+                outBuf.push_back(e);
+                if (outBuf.size() == MIN_RUN_BUFFER) flush();
+                return true;
+            });
+            flush();
+            if (!out) throw std::runtime_error("could not write " + merged.back()->path.string());
+        }
+        runs = std::move(merged);
+    }
+
+    //phase 3: final merge feeds Kruskal directly
+    mergeRuns(runs, budgetEdges / runs.size(), kruskal);
+    if (components) *components = forestComponents(mst, UF);
+    return mst;
+}
+
+}  // namespace
+
+Graph externalMST(const std::string& inputFile, const ExternalOptions& options) {
+    return externalForest(inputFile, options, nullptr);
+}
+
+Graph externalMST(const std::string& inputFile, ForestComponents& components,
+                  const ExternalOptions& options) {
+    return externalForest(inputFile, options, &components);
+}
@@ -0,0 +1,26 @@
+#ifndef EXTERNAL_MST_HPP_
+#define EXTERNAL_MST_HPP_
+
+#include "graph.hpp"
+#include <string>
+#include <cstddef>
+
+struct ForestComponents;
+
+//options for the semi-external MST
+struct ExternalOptions {
+    std::size_t memoryBudget {64u << 20};   //bytes used for edge buffers (vertex state comes on top)
+    std::string tempDir {};                 //directory for sorted runs, empty: system temp directory
+};
+
+//Semi-external MST (external sorting + Kruskal)
+//streams the edge list from inputFile (same format as Graph(inputFile)) in chunks that fit
+//the memory budget, writes sorted runs to disk, then merges the runs while running Kruskal.
+//Only the UnionFind (O(n)) and the output forest are kept in memory.
+//edge IDs are assigned in file order, as Graph(inputFile) does
+Graph externalMST(const std::string& inputFile, const ExternalOptions& options = {});
+//same, also returning the trees of the forest in components (taken from Kruskal's UnionFind)
+Graph externalMST(const std::string& inputFile, ForestComponents& components,
+                  const ExternalOptions& options = {});
+
+#endif      // EXTERNAL_MST_HPP_
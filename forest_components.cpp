@@ -0,0 +1,60 @@
+#include "forest_components.hpp"
+#include "union_find.hpp"
+#include "spanning_forest.hpp"
+#include "graph.hpp"
+#include <vector>
+
+namespace {
+
+//labels and sizes from UF, edge lists left empty
+ForestComponents componentsOf(Index n, UnionFind& UF) {
+    ForestComponents C;
+    C.label.resize(n);
+    std::vector<Index> rootLabel(n, -1);            //component of each UF root
+    for (Index v = 0; v < n; ++v) {
+        Index root = UF.find(v);
+        if (rootLabel[root] == -1) {
+            rootLabel[root] = C.numComponents();
+            C.size.push_back(UF.size(root));
+        }
+        C.label[v] = rootLabel[root];
+    }
+    C.edges.resize(C.numComponents());
+    C.weight.assign(C.numComponents(), 0);
+    for (Index c = 0; c < C.numComponents(); ++c) C.edges[c].reserve(C.size[c] - 1);
+    return C;
+}
+
+void addToComponent(ForestComponents& C, const Graph::Edge& e) {
+    Index c = C.label[e.v1];
+    C.edges[c].push_back(e);
+    C.weight[c] += e.weight;
+}
+
+}  // namespace
+
+ForestComponents forestComponents(const Graph& F, UnionFind& UF) {
+    ForestComponents C = componentsOf(F.numVertices(), UF);
+    for (Index u = 0; u < F.numVertices(); ++u) {
+        for (const auto& e : *F.neighbours(u)) {
+            if (u == e.v1) addToComponent(C, e);        //avoid duplicate edge
+        }
+    }
+    return C;
+}
+
+ForestComponents forestComponents(const SpanningForest& F, UnionFind& UF) {
+    ForestComponents C = componentsOf(F.numVertices, UF);
+    for (const auto& e : F.edges) addToComponent(C, e);
+    return C;
+}
+
+ForestComponents forestComponents(const Graph& F) {
+    UnionFind UF(F.numVertices());
+    for (Index u = 0; u < F.numVertices(); ++u) {
+        for (const auto& e : *F.neighbours(u)) {
+            if (u == e.v1) UF.merge(e.v1, e.v2);
+        }
+    }
+    return forestComponents(F, UF);
+}
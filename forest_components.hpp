@@ -0,0 +1,31 @@
+#ifndef FOREST_COMPONENTS_HPP_
+#define FOREST_COMPONENTS_HPP_
+
+#include "graph.hpp"
+#include "union_find.hpp"
+#include <vector>
+
+struct SpanningForest;
+
+//trees of a minimum spanning forest, one entry per connected component of the input
+//components are numbered by their smallest vertex
+struct ForestComponents {
+    std::vector<Index> label;                       //label[v]: component of vertex v
+    std::vector<std::vector<Graph::Edge>> edges;    //forest edges of each component
+    std::vector<WeightSum> weight;                  //forest weight of each component
+    std::vector<Index> size;                        //number of vertices of each component
+
+    Index numComponents() const {
+        return static_cast<Index>(size.size());
+    }
+};
+
+//components of forest F whose trees are exactly the sets of UF (the state an engine ends with)
+//O(n + edges of F), no pass over the input graph
+ForestComponents forestComponents(const Graph& F, UnionFind& UF);
+//same for a flat forest, edges of each component in the order of F.edges
+ForestComponents forestComponents(const SpanningForest& F, UnionFind& UF);
+//components of forest F, building the UnionFind from F's edges
+ForestComponents forestComponents(const Graph& F);
+
+#endif      // FOREST_COMPONENTS_HPP_
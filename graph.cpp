@@ -1,4 +1,5 @@
 #include "graph.hpp"
+#include "thread_pool.hpp"
 #include <vector>
 #include <set>
 #include <string>
@@ -10,15 +11,15 @@
 #include <functional>
 #include <iostream>
 
+// no padding in the 32-bit configurations (float/int32 weights with 32-bit ids: 16 bytes)
+static_assert(sizeof(Weight) != 4 || sizeof(Index) != 4 || sizeof(Graph::Edge) == 16);
 
 // Graph member functions
 Graph::Graph() = default;
 
-Graph::Graph(int n, std::vector<Edge> vec)
+Graph::Graph(Index n, std::vector<Edge> vec)
              : adjList {std::vector<std::vector<Edge> >(n)}, nextEdgeId {0} {
-  for (const Edge& e : vec) {
-    addEdge(e);
-  }
+  addEdges(std::move(vec));
 }
 
 
@@ -29,17 +30,19 @@ Graph::Graph(const std::string& inputFile) {
     return;
   }
   // first line has number of vertices N
-  int N {};
+  Index N {};
   infile >> N;
   adjList.resize(N);
-  int i {};
-  int j {};
-  double weight {};
+  Index i {};
+  Index j {};
+  Weight weight {};
   // assume each remaining line is of form
   // origin dest weight
+  std::vector<Edge> edges;
   while (infile >> i >> j >> weight) {
-    addEdge({weight, i, j});
+    edges.push_back({weight, i, j});
   }
+  addEdges(std::move(edges));
 }
 
 void Graph::addEdge(Edge e) {
@@ -64,13 +67,112 @@ void Graph::addEdge(Edge e) {
   }
 }
 
-int Graph::numVertices() const {
-  return static_cast<int>(adjList.size());
+void Graph::addEdges(std::vector<Edge> edges) {
+  const Index n = numVertices();
+  // drop invalid edges and assign IDs in order, exactly like addEdge,
+  // counting how many entries every adjacency list gains
+  std::vector<std::size_t> degree(n, 0);
+  idOriginal.reserve(idOriginal.size() + edges.size());
+  std::size_t kept = 0;
+  for (Edge e : edges) {
+    if (e.v1 < 0 || e.v2 < 0 || e.v1 >= n || e.v2 >= n) continue;
+    if (e.edgeId == -1) {
+      e.edgeId = nextEdgeId++;
+    }
+    else if (e.edgeId >= nextEdgeId) {
+      nextEdgeId = e.edgeId + 1;
+    }
+    idOriginal.insert({e.edgeId, e});   // keeps the first edge seen with this ID
+    ++degree[e.v1];
+    ++degree[e.v2];
+    edges[kept++] = e;
+  }
+  edges.resize(kept);
+
+  // one vertex range per part with about the same number of entries
+  const std::size_t MIN_EDGES_PER_THREAD = 1 << 18;
+  ThreadPool& pool = globalThreadPool();
+  std::size_t numThreads = std::min<std::size_t>(pool.numThreads(), kept / MIN_EDGES_PER_THREAD);
+  if (numThreads <= 1) {
+    for (Index v = 0; v < n; ++v) {
+      adjList[v].reserve(adjList[v].size() + degree[v]);
+    }
+    for (const Edge& e : edges) {
+      adjList[e.v1].push_back(e);
+      adjList[e.v2].push_back(e);
+    }
+    return;
+  }
+  std::vector<Index> bounds {0};
+  std::size_t entries = 0;
+  for (Index v = 0; v < n; ++v) {
+    entries += degree[v];
+    if (entries * numThreads >= 2 * kept * bounds.size() && bounds.size() < numThreads) {
+      bounds.push_back(v + 1);
+    }
+  }
+  bounds.push_back(n);
+  const int numParts = static_cast<int>(bounds.size()) - 1;
+  std::vector<int> owner(n);
+  for (int p = 0; p < numParts; ++p) {
+    std::fill(owner.begin() + bounds[p], owner.begin() + bounds[p + 1], p);
+  }
+
+  // bucket the edge positions by owning part (an edge goes to the parts of both endpoints),
+  // so every part reads only its own edges: chunk c of the edge list counts its entries per
+  // part, then writes them behind those of chunks 0 .. c - 1, keeping edge order in a bucket
+  auto chunk = [kept, numParts](int c) { return kept * c / numParts; };
+  std::vector<std::size_t> cursor(static_cast<std::size_t>(numParts) * numParts, 0);  // [c * numParts + p]
+  pool.parallelParts(numParts, [&](int c) {
+    std::size_t* count = cursor.data() + static_cast<std::size_t>(c) * numParts;
+    for (std::size_t i = chunk(c); i < chunk(c + 1); ++i) {
+      int p1 = owner[edges[i].v1];
+      int p2 = owner[edges[i].v2];
+      ++count[p1];
+      if (p2 != p1) ++count[p2];
+    }
+  });
+  std::vector<std::size_t> bucketStart(numParts + 1, 0);
+  for (int p = 0; p < numParts; ++p) {
+    std::size_t position = bucketStart[p];
+    for (int c = 0; c < numParts; ++c) {
+      std::size_t count = cursor[static_cast<std::size_t>(c) * numParts + p];
+      cursor[static_cast<std::size_t>(c) * numParts + p] = position;
+      position += count;
+    }
+    bucketStart[p + 1] = position;
+  }
+  std::vector<std::size_t> bucket(bucketStart[numParts]);
+  pool.parallelParts(numParts, [&](int c) {
+    std::size_t* next = cursor.data() + static_cast<std::size_t>(c) * numParts;
+    for (std::size_t i = chunk(c); i < chunk(c + 1); ++i) {
+      int p1 = owner[edges[i].v1];
+      int p2 = owner[edges[i].v2];
+      bucket[next[p1]++] = i;
+      if (p2 != p1) bucket[next[p2]++] = i;
+    }
+  });
+
+  // every part fills the adjacency lists of its vertices from its bucket
+  pool.parallelParts(numParts, [&](int p) {
+    for (Index v = bounds[p]; v < bounds[p + 1]; ++v) {
+      adjList[v].reserve(adjList[v].size() + degree[v]);
+    }
+    for (std::size_t k = bucketStart[p]; k < bucketStart[p + 1]; ++k) {
+      const Edge& e = edges[bucket[k]];
+      if (owner[e.v1] == p) adjList[e.v1].push_back(e);
+      if (owner[e.v2] == p) adjList[e.v2].push_back(e);
+    }
+  });
+}
+
+Index Graph::numVertices() const {
+  return static_cast<Index>(adjList.size());
 }
 
-double Graph::edgeWeightSum() const {
-  double totalWeight {0.0};
-  for (int i = 0; i < numVertices(); ++i) {
+WeightSum Graph::edgeWeightSum() const {
+  WeightSum totalWeight {0};
+  for (Index i = 0; i < numVertices(); ++i) {
     for (const Edge& e : *neighbours(i)) {
       totalWeight += e.weight;
     }
@@ -80,10 +182,53 @@ double Graph::edgeWeightSum() const {
 }
 
 //get original edge in G from edgeID
-const Graph::Edge &Graph::edgeByID(int edgeId) const {
+const Graph::Edge &Graph::edgeByID(Index edgeId) const {
   return idOriginal.at(edgeId);
 }
 
+Graph canonicalForm(const Graph& G) {
+  std::vector<Graph::Edge> edges;
+  for (Index u = 0; u < G.numVertices(); ++u) {
+    Index previousId = -1;
+    for (const Graph::Edge& e : *G.neighbours(u)) {
+      if (u != e.v1) continue;  // avoid duplicate edge
+      if (e.v1 == e.v2 && e.edgeId == previousId) continue;  // second copy of a self-loop
+      previousId = e.edgeId;
+      edges.push_back(e);
+    }
+  }
+  std::stable_sort(edges.begin(), edges.end(),
+                   [](const Graph::Edge& a, const Graph::Edge& b) { return a.edgeId < b.edgeId; });
+  return Graph(G.numVertices(), std::move(edges));
+}
+
+bool operator==(const Graph& G, const Graph& H) {
+  return std::equal(G.begin(), G.end(), H.begin(), H.end());
+}
+
+bool Graph::hasEdgeID(Index edgeId) const {
+  return idOriginal.count(edgeId) > 0;
+}
+
+std::size_t Graph::memoryBytes() const {
+  std::size_t bytes = sizeof(Graph) + adjList.capacity() * sizeof(std::vector<Edge>);
+  for (const auto& adj : adjList) {
+    bytes += adj.capacity() * sizeof(Edge);
+  }
+  // hash map: bucket array plus one node (next pointer + key/value) per edge
+  bytes += idOriginal.bucket_count() * sizeof(void*);
+  bytes += idOriginal.size() * (sizeof(void*) + sizeof(std::pair<const Index, Edge>));
+  return bytes;
+}
+
+std::size_t Graph::memoryEstimate(Index n, std::size_t numEdges) {
+  std::size_t bytes = sizeof(Graph) + static_cast<std::size_t>(n) * sizeof(std::vector<Edge>);
+  bytes += 3 * numEdges * sizeof(Edge);         // both adjacency lists and the input vector
+  bytes += 2 * numEdges * sizeof(void*);        // ID map buckets (the count is rounded up, to under twice the size)
+  bytes += numEdges * (sizeof(void*) + sizeof(std::pair<const Index, Edge>));
+  return bytes;
+}
+
 // print out adjacency list of a Graph
 std::ostream& operator<<(std::ostream& out, const Graph& G) {
   for (Graph::iterator it = G.begin(); it != G.end(); ++it) {
@@ -6,36 +6,41 @@
 #include <set>
 #include <vector>
 #include <unordered_map>
+#include <cstddef>
+#include "types.hpp"
 
 // Class for undirected graphs with edge weights
 class Graph {
  public:
   struct Edge {
-    double weight {};
-    int v1 {};
-    int v2 {};
-    int edgeId {-1};  //edgeID to keep track of the edges after contraction
+    Weight weight {};
+    Index v1 {};
+    Index v2 {};
+    Index edgeId {-1};  //edgeID to keep track of the edges after contraction
     auto operator<=>(const Edge&) const = default;
   };
 
  private:
   std::vector<std::vector<Edge> > adjList {};
-  int nextEdgeId {}; // to assign unique edge IDs
-  std::unordered_map<int,Edge> idOriginal; //original edge by id
+  Index nextEdgeId {}; // to assign unique edge IDs
+  std::unordered_map<Index,Edge> idOriginal; //original edge by id
 
  public:
   // default constructor
   Graph();
   // construct graph with n vertices and optionally provide
-  // a vector of edges
-  explicit Graph(int n, std::vector<Edge> = {});
+  // a vector of edges (added in bulk, see addEdges)
+  explicit Graph(Index n, std::vector<Edge> = {});
 
   // read list of edges in from a file
   explicit Graph(const std::string& inputFile);
 
   void addEdge(Edge);
-  int numVertices() const;
-  double edgeWeightSum() const;
+  // add many edges at once, same result as calling addEdge on each in order
+  // but every adjacency list is allocated once (filled in parallel for large inputs)
+  void addEdges(std::vector<Edge>);
+  Index numVertices() const;
+  WeightSum edgeWeightSum() const;
 
   using iterator = std::vector<std::vector<Edge> >::const_iterator;
 
@@ -49,14 +54,35 @@ class Graph {
   }
 
   // return iterator to a particular vertex
-  iterator neighbours(int a) const {
+  iterator neighbours(Index a) const {
     return adjList.cbegin() + a;
   }
   //get original edge by ID 
-  const Edge& edgeByID(int edgeId) const;
+  const Edge& edgeByID(Index edgeId) const;
+  //is there an edge with this ID?
+  bool hasEdgeID(Index edgeId) const;
+  //approximate heap + object footprint in bytes (adjacency lists and ID map)
+  std::size_t memoryBytes() const;
+  //footprint of Graph(n, edges) with numEdges edges while it is built (the edge vector
+  //passed in included), to check a memory budget before building it
+  static std::size_t memoryEstimate(Index n, std::size_t numEdges);
   
 };
 
+// total order on edges used by every MST engine: by weight, ties broken by
+// edge ID, so with distinct IDs the minimum spanning forest is unique
+inline bool lighterEdge(const Graph::Edge& a, const Graph::Edge& b) {
+  if (a.weight != b.weight) return a.weight < b.weight;
+  return a.edgeId < b.edgeId;
+}
+
+// canonical form of a graph: the same edges added in edge ID order, so equal
+// edge sets (e.g. the forests of two MST engines) give identical adjacency lists
+Graph canonicalForm(const Graph&);
+
+// true if both graphs have identical adjacency lists
+bool operator==(const Graph&, const Graph&);
+
 // print out a Graph
 std::ostream& operator<<(std::ostream&, const Graph&);
 
@@ -1,43 +1,49 @@
 #include "union_find.hpp"
 #include "graph.hpp"
-#include <unordered_map>
 #include "kkt.hpp"
 #include <random>
+#include <algorithm>
+#include <optional>
 #include "lca.hpp"
+#include "boruvka_kernel.hpp"
+#include "memory_tracker.hpp"
+#include "forest_components.hpp"
+#include "mst_control.hpp"
+#include "spanning_forest.hpp"
+
+namespace {
+
+//edges of G (self-loops counted once), from the adjacency list sizes
+std::size_t edgeCount(const Graph& G) {
+    std::size_t entries = 0;
+    for (const auto& list : G) entries += list.size();
+    return entries / 2;
+}
+
+}  // namespace
 
 //Boruvka step to return the chosen edges and the connected components (supernode) for next round
 //time complexity: O(ma(n)) ~ O(m)
-std::pair<std::vector<Graph::Edge>, Graph> boruvkaStep(const Graph& G) {
-    int n = G.numVertices();
+std::pair<std::vector<Graph::Edge>, Graph> boruvkaStep(const Graph& G, MemoryTracker* tracker) {
+    Index n = G.numVertices();
+    std::size_t m = edgeCount(G);
+    //every structure is charged before it is allocated, from its size (or a bound on it)
+    //scratch: union-find, labels, cheapest edges, chosen edges and the edge arrays
+    std::size_t vertices = static_cast<std::size_t>(n);
+    MemoryCharge scratch(tracker, sizeof(UnionFind) + vertices * (4 * sizeof(Index) + sizeof(int) + sizeof(Graph::Edge)) +
+                                  m * (sizeof(Weight) + 3 * sizeof(Index)));
     UnionFind UF(n);
-    std::vector<Graph::Edge> cheapest(n);
-    std::vector<bool> hasCheapest(n, false);
-    for (int u = 0; u < n; ++u) {
-        for (auto e : *G.neighbours(u)) {
-            if (u != e.v1) continue;                        //avoid duplicate edge
-            int comp1 = UF.find(e.v1);
-            int comp2 = UF.find(e.v2);
-
-            if (comp1 == comp2) continue;                   //v1 and v2 are in same component
-
-            //update cheapest edge for component root1
-            if (!hasCheapest[comp1] || e.weight < cheapest[comp1].weight) {
-                cheapest[comp1] = e;
-                hasCheapest[comp1] = true;
-            }
-            //update cheapest edge for component root2
-            if (!hasCheapest[comp2] || e.weight < cheapest[comp2].weight) {
-                cheapest[comp2] = e;
-                hasCheapest[comp2] = true;
-            }
-        }
-    }
+    EdgeArrays E(G);
+    std::vector<Index> label(n);
+    for (Index v = 0; v < n; ++v) label[v] = v;        //every vertex is its own component
+    std::vector<Index> cheapest;
+    boruvkaScan(E, label, cheapest);
     std::vector<Graph::Edge> chosen;  //edges chosen in this Boruvka step (will be part of MST)
-    for (int v = 0; v < n; ++v) {
-        if (!hasCheapest[v]) continue;
-        auto e = cheapest[v];
-        int comp1 = UF.find(e.v1);
-        int comp2 = UF.find(e.v2);
+    for (Index v = 0; v < n; ++v) {
+        if (cheapest[v] == -1) continue;
+        auto e = E.edge(cheapest[v]);
+        Index comp1 = UF.find(e.v1);
+        Index comp2 = UF.find(e.v2);
 
         if (comp1 == comp2) continue;
 
@@ -46,47 +52,34 @@ std::pair<std::vector<Graph::Edge>, Graph> boruvkaStep(const Graph& G) {
     }
     //construct the contract graph G1
     
-    //vertices in the same component in UF are contracted into a supernode
-    std::vector<int> vertexSuperNode(n);                //keep track of vertex's current supernode
-    std::unordered_map<int, int> superNodes;            //map the component to new supernode id
-    int compCount = 0;
-    for (int v = 0; v < n; ++v) {
-        int comp = UF.find(v);
-        //assign new id (compCount) if the component is not mapped yet
-        if (superNodes.find(comp) == superNodes.end()) {
-            superNodes[comp] = compCount;
-            vertexSuperNode[v] = superNodes[comp];
-            ++compCount;
-        }
-        else {
-            vertexSuperNode[v] = superNodes[comp];
-        }
+    //vertices in the same component in UF are contracted into a supernode, numbered in order
+    //of their first vertex (rootNode: supernode of each UF root)
+    MemoryCharge superNodeBytes(tracker, 2 * vertices * sizeof(Index));
+    std::vector<Index> vertexSuperNode(n);                //keep track of vertex's current supernode
+    std::vector<Index> rootNode(n, -1);
+    Index compCount = 0;
+    for (Index v = 0; v < n; ++v) {
+        Index root = UF.find(v);
+        if (rootNode[root] == -1) rootNode[root] = compCount++;
+        vertexSuperNode[v] = rootNode[root];
     }
     
-    //choosing the lightest edge crossing the cut
-    std::unordered_map<std::pair<int,int>, Graph::Edge, pairhash> lightest;
-    lightest.reserve(n*4);
-    
-    for (int u = 0; u < n; ++u) {
-        for (auto e : *G.neighbours(u)) {
-            if (u != e.v1) continue;                    //avoid duplicate edge
-            int su = vertexSuperNode[u];                //supernode of vertex u
-            int sv = vertexSuperNode[e.v2];             //supernode of vertex v
-
-            if (su == sv) continue;                     //both endpoints are in same supernode (delete self-loop)
-            std::pair<int,int> k = makeOrderedPair(su, sv);
-            if (!lightest.count(k) || lightest.at(k).weight > e.weight) {
-                lightest[k] = {e.weight, su, sv, e.edgeId};
-            }
-        }
-    }
-
-    //now add edges to the contracted graph
-
-    Graph contracted(compCount);
-    for (const auto& e : lightest) {
-        contracted.addEdge(e.second);
+    //choosing the lightest edge crossing the cut, with the bucket pass of boruvkaHierarchy
+    //(buckets and owners per supernode, bucketed and kept positions per edge)
+    std::size_t superNodes = static_cast<std::size_t>(compCount);
+    MemoryCharge lightestBytes(tracker, superNodes * (sizeof(std::size_t) + 2 * sizeof(Index)) +
+                                        static_cast<std::size_t>(E.size()) * 2 * sizeof(Index));
+    std::vector<Index> lightest = contractEdges(E, vertexSuperNode.data(), compCount);
+
+    //now add edges to the contracted graph (the caller charges it once it is returned)
+    MemoryCharge contractedBytes(tracker, Graph::memoryEstimate(compCount, lightest.size()));
+    std::vector<Graph::Edge> contractedEdges;
+    contractedEdges.reserve(lightest.size());
+    for (Index i : lightest) {
+        auto e = E.edge(i);
+        contractedEdges.push_back({e.weight, vertexSuperNode[e.v1], vertexSuperNode[e.v2], e.edgeId});
     }
+    Graph contracted(compCount, std::move(contractedEdges));
 
     return {chosen, contracted};
 }
@@ -98,73 +91,144 @@ bool randomChoice() {
     return dist(mt);
 }
 
-Graph kktMST(const Graph& G) {
-    int n = G.numVertices();
-    Graph mst(n);
+namespace {
+
+//KKT on subproblem G at the given recursion depth, with optional accounting and checkpoints
+//the forest comes back as a flat edge list; the subproblems (contracted G1, sample H, filtered G2)
+//are Graphs, and the sample forest F is built into one for the LCA tables
+SpanningForest kktRecursive(const Graph& G, MemoryTracker* tracker, const MSTControl* control, int depth) {
+    Index n = G.numVertices();
+    if (control) control->checkpoint({"kkt", n, depth, 0});
+    SpanningForest mst(n);
     //base case
     if (n <= 1) return mst;
     
-    // Check if graph has any edges
-    if (G.edgeWeightSum()==0) return mst;
+    //no edges, nothing to choose (the weights may well sum to 0 when there are)
+    if (std::all_of(G.begin(), G.end(), [](const auto& list) { return list.empty(); })) return mst;
 
     //running 2 Boruvka steps on G
-    auto s1 = boruvkaStep(G);
-    auto s2 = boruvkaStep(s1.second);
-    const auto B1 = s1.first;     //chosen edges from first Boruvka step
-    const auto B2 = s2.first;     //chosen edges from second Boruvka step
-    Graph G1 = s2.second;      //contracted graph
-
-
-    Graph H(G1.numVertices());
-    //random sampling each edge with probability 1/2
-    for (int u = 0; u < G1.numVertices(); ++u) {
-        for (auto e : *G1.neighbours(u)) {
-            if (u != e.v1) continue;
-            if (randomChoice()) {
-                H.addEdge(e);
+    std::vector<Graph::Edge> B1;    //chosen edges from first Boruvka step
+    std::vector<Graph::Edge> B2;    //chosen edges from second Boruvka step
+    Graph G1;                       //contracted graph
+    {
+        MemoryPhase phase(tracker, "kkt boruvka steps");
+        auto s1 = boruvkaStep(G, tracker);
+        MemoryCharge s1Bytes(tracker, s1.second.memoryBytes());
+        auto s2 = boruvkaStep(s1.second, tracker);
+        B1 = std::move(s1.first);
+        B2 = std::move(s2.first);
+        G1 = std::move(s2.second);
+    }   //the first contracted graph is freed here
+    MemoryCharge chosenBytes(tracker, (B1.capacity() + B2.capacity()) * sizeof(Graph::Edge));
+    MemoryCharge G1Bytes(tracker, G1.memoryBytes());
+
+    std::size_t m1 = edgeCount(G1);
+
+    SpanningForest F;
+    {
+        MemoryPhase phase(tracker, "kkt sampling");
+        MemoryCharge sampledBytes(tracker, m1 * sizeof(Graph::Edge));   //at most every edge
+        std::vector<Graph::Edge> sampled;
+        //random sampling each edge with probability 1/2
+        for (Index u = 0; u < G1.numVertices(); ++u) {
+            for (auto e : *G1.neighbours(u)) {
+                if (u != e.v1) continue;
+                if (randomChoice()) {
+                    sampled.push_back(e);
+                }
             }
         }
-    }
-    //recursive call on H to find MSF of subproblem
-    Graph F = kktMST(H);
-
-    //find F-heavy edges in G1 and remove them
-    LCA lca(F); 
-    Graph G2(G1.numVertices()); //graph after removing F-heavy edges
-
-    for (int u = 0; u < G1.numVertices(); ++u) {
-        for (auto e : *G1.neighbours(u)) {
-            if (u != e.v1) continue;
-            double maxW = lca.maxEdgeWeight(e.v1, e.v2);
-            if (e.weight > maxW) continue; // Skip F-heavy edges
-            G2.addEdge(e);
+        sampledBytes.release();                                         //moved into H, counted there
+        MemoryCharge HBytes(tracker, Graph::memoryEstimate(G1.numVertices(), sampled.size()));
+        Graph H(G1.numVertices(), std::move(sampled));
+        //recursive call on H to find MSF of subproblem
+        F = kktRecursive(H, tracker, control, depth + 1);
+    }   //H is freed here
+    MemoryCharge FBytes(tracker, F.memoryBytes());
+
+    Graph G2;                       //graph after removing F-heavy edges
+    std::optional<MemoryCharge> G2Bytes;
+    {
+        MemoryPhase phase(tracker, "kkt F-heavy filter");
+        //find F-heavy edges in G1 and remove them
+        std::size_t forestEdges = F.edges.size();
+        MemoryCharge forestGraphBytes(tracker, Graph::memoryEstimate(G1.numVertices(), forestEdges));
+        MemoryCharge lcaBytes(tracker, LCA::memoryEstimate(G1.numVertices(), forestEdges));
+        LCA lca(F.toGraph());
+        forestGraphBytes.release();
+        MemoryCharge lightBytes(tracker, m1 * sizeof(Graph::Edge));     //at most every edge
+        std::vector<Graph::Edge> light;     //edges of G1 that are not F-heavy
+
+        for (Index u = 0; u < G1.numVertices(); ++u) {
+            for (auto e : *G1.neighbours(u)) {
+                if (u != e.v1) continue;
+                Weight maxW = lca.maxEdgeWeight(e.v1, e.v2);
+                if (e.weight > maxW) continue; // Skip F-heavy edges (ties stay, G2 keeps its MSF)
+                light.push_back(e);
+            }
         }
-    }
+        lightBytes.release();                                           //moved into G2, counted there
+        G2Bytes.emplace(tracker, Graph::memoryEstimate(G1.numVertices(), light.size()));
+        G2 = Graph(G1.numVertices(), std::move(light));
+    }   //LCA tables are freed here
+    //G1 and F are not needed any more
+    G1 = Graph();
+    G1Bytes.release();
+    F = SpanningForest();
+    FBytes.release();
+
     //recursive call on G2 to find MSF
-    Graph F2 = kktMST(G2);
+    SpanningForest F2 = kktRecursive(G2, tracker, control, depth + 1);
+    G2 = Graph();
+    G2Bytes.reset();
     
-    //mst is union of F2 and B
-    for (int u = 0; u < F2.numVertices(); ++u) {
-        for (auto e : *F2.neighbours(u)) {
-            if (u != e.v1) continue;
-            mst.addEdge(G.edgeByID(e.edgeId));
-        }
+    //mst is union of F2 and B (the caller charges it once it is returned)
+    MemoryCharge mstBytes(tracker, (B1.size() + B2.size() + F2.edges.size()) * sizeof(Graph::Edge));
+    mst.edges.reserve(B1.size() + B2.size() + F2.edges.size());
+    for (const auto& e : F2.edges) {
+        mst.add(G.edgeByID(e.edgeId));
     }
 
-    for (auto e : B1) {
-        mst.addEdge(e);
+    for (const auto& e : B1) {
+        mst.add(e);
     }
 
-    for (auto e : B2) {
-        mst.addEdge(G.edgeByID(e.edgeId));
+    for (const auto& e : B2) {
+        mst.add(G.edgeByID(e.edgeId));
     }
 
     return mst;
 }
 
+}  // namespace
+
+Graph kktMST(const Graph& G) {
+    return kktRecursive(G, nullptr, nullptr, 0).toGraph();
+}
+
+Graph kktMST(const Graph& G, MemoryTracker* tracker) {
+    return kktRecursive(G, tracker, nullptr, 0).toGraph();
+}
+
+Graph kktMST(const Graph& G, ForestComponents& components) {
+    SpanningForest mst = kktRecursive(G, nullptr, nullptr, 0);
+    UnionFind UF(mst.numVertices);
+    for (const auto& e : mst.edges) UF.merge(e.v1, e.v2);
+    components = forestComponents(mst, UF);
+    return mst.toGraph();
+}
+
+Graph kktMST(const Graph& G, const MSTControl& control) {
+    return kktRecursive(G, nullptr, &control, 0).toGraph();
+}
+
+SpanningForest kktSpanningForest(const Graph& G) {
+    return kktRecursive(G, nullptr, nullptr, 0);
+}
+
 
 //helper functions
-std::pair<int, int> makeOrderedPair(int a, int b) {
+std::pair<Index, Index> makeOrderedPair(Index a, Index b) {
     if (a > b) std::swap(a, b);
     return {a, b};
 }
\ No newline at end of file
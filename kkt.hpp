@@ -6,14 +6,31 @@
 #include <utility>
 #include <unordered_map>
 
+class MemoryTracker;
+struct ForestComponents;
+class MSTControl;
+struct SpanningForest;
+
 //Boruvka step to return the chosen edges and the connected components (supernode) for next round
-std::pair<std::vector<Graph::Edge>, Graph> boruvkaStep(const Graph& G);
+//its scratch memory is charged to tracker if one is given, from size bounds before it is allocated
+std::pair<std::vector<Graph::Edge>, Graph> boruvkaStep(const Graph& G, MemoryTracker* tracker = nullptr);
 
 //random function to choose edges with probability 1/2
 bool randomChoice();
 
 //KKT MST algorithm
 Graph kktMST(const Graph& G);
+//same, charging the graphs and LCA tables alive at each recursion level to tracker
+//(each charge is taken from a size estimate before the structure is allocated, so an over-budget
+//level throws MemoryBudgetError without having built anything)
+Graph kktMST(const Graph& G, MemoryTracker* tracker);
+//same, also returning the trees of the forest in components (O(n) pass over the forest only)
+Graph kktMST(const Graph& G, ForestComponents& components);
+//same, with a checkpoint of control on every subproblem (may throw MSTCancelled)
+Graph kktMST(const Graph& G, const MSTControl& control);
+//same forest as a flat edge list, without building the result into a Graph (the contracted,
+//sampled and filtered subproblems of every recursion level still are Graphs)
+SpanningForest kktSpanningForest(const Graph& G);
 //from github repo
 //https://gist.github.com/VladimirReshetnikov/ac9bcabc652dcbeaf83a3f1328a1099b
 struct pairhash final {
@@ -26,7 +43,7 @@ struct pairhash final {
     }
 };
 //make an ordered pair (smaller value first)
-std::pair<int, int> makeOrderedPair(int a, int b);
+std::pair<Index, Index> makeOrderedPair(Index a, Index b);
 
 #endif      //KKT_HPP_
 
@@ -5,8 +5,8 @@
 #include <limits>
 #include <algorithm>
 
-const double NEG_INF = std::numeric_limits<double>::lowest();
-const double INF = std::numeric_limits<double>::infinity();
+const Weight NEG_INF = WEIGHT_MIN;
+const Weight INF = WEIGHT_MAX;
 
 LCA::LCA(const Graph& F) {
     n = F.numVertices();
@@ -15,27 +15,29 @@ LCA::LCA(const Graph& F) {
     level.assign(n, -1);
     rootID.assign(n, -1);
     log = 0;
-    int p = 1; //p = 2^k
+    Index p = 1; //p = 2^k
     while (p <= n) {
         p *= 2;
         ++log;
     }
-    up.assign(n, std::vector<int>(log, -1)); //table size n x log, -1 means root node
-    maxWeight.assign(n, std::vector<double>(log, 0.0));
+    up.assign(n, std::vector<Index>(log, -1)); //table size n x log, -1 means root node
+    maxWeight.assign(n, std::vector<Weight>(log, 0));
 
-    //construct adjacency list from graph F
-    for (auto it = F.begin(); it != F.end(); ++it) {
-        for (auto e : *it) {
+    //construct adjacency list from graph F (each edge once per endpoint, lists allocated once)
+    for (Index v = 0; v < n; ++v) adjList[v].reserve(F.neighbours(v)->size());
+    for (Index u = 0; u < n; ++u) {
+        for (auto e : *F.neighbours(u)) {
+            if (u != e.v1) continue;                    //the copy in the list of v2
             adjList[e.v1].push_back(e);
-            adjList[e.v2].push_back(e);
+            if (e.v2 != e.v1) adjList[e.v2].push_back(e);
         }
     }
     //build the tables
     preprocessing(); 
 }
 
-double LCA::maxEdgeWeight(int u, int v) {
-    double maxW = NEG_INF;
+Weight LCA::maxEdgeWeight(Index u, Index v) {
+    Weight maxW = NEG_INF;
     
     // Return INF for disconnected vertices (no path exists)
     if (rootID[u] != rootID[v]) return INF;
@@ -76,11 +78,33 @@ double LCA::maxEdgeWeight(int u, int v) {
 }
 
 
+std::size_t LCA::memoryEstimate(Index n, std::size_t numEdges) {
+    std::size_t log = 0;
+    for (Index p = 1; p <= n; p *= 2) ++log;
+    std::size_t nodes = static_cast<std::size_t>(n);
+    return sizeof(LCA) + nodes * sizeof(std::vector<Graph::Edge>) + 2 * numEdges * sizeof(Graph::Edge) +
+           3 * nodes * sizeof(Index) + nodes * (sizeof(std::vector<Index>) + log * sizeof(Index)) +
+           nodes * (sizeof(std::vector<Weight>) + log * sizeof(Weight));
+}
+
+std::size_t LCA::memoryBytes() const {
+    std::size_t bytes = sizeof(LCA);
+    bytes += adjList.capacity() * sizeof(std::vector<Graph::Edge>);
+    for (const auto& adj : adjList) bytes += adj.capacity() * sizeof(Graph::Edge);
+    bytes += (parent.capacity() + level.capacity() + rootID.capacity()) * sizeof(Index);
+    bytes += up.capacity() * sizeof(std::vector<Index>);
+    for (const auto& row : up) bytes += row.capacity() * sizeof(Index);
+    bytes += maxWeight.capacity() * sizeof(std::vector<Weight>);
+    for (const auto& row : maxWeight) bytes += row.capacity() * sizeof(Weight);
+    return bytes;
+}
+
+
 //helper functions
 
-void LCA::dfs(int u, int p, int r) {
+void LCA::dfs(Index u, Index p, Index r) {
     for (auto e : adjList[u]) {
-        int v;
+        Index v;
         if (u == e.v1 ) v = e.v2; else v = e.v1;
         if (v == p) continue; //skip parent
         if (level[v] != -1) continue; //already visited
@@ -95,7 +119,7 @@ void LCA::dfs(int u, int p, int r) {
 
 void LCA::preprocessing() {
     //initialise root(s)
-    for (int root  = 0; root < n; ++root) {
+    for (Index root  = 0; root < n; ++root) {
         if (level[root] != -1) continue;
         parent[root] = -1;
         up[root][0] = -1;
@@ -106,7 +130,7 @@ void LCA::preprocessing() {
     }
     //build binary lifting tables
     for (int i = 1; i < log; ++i) {
-        for (int v = 0; v < n; ++v) {
+        for (Index v = 0; v < n; ++v) {
             if (up[v][i - 1] == -1) continue; //no 2^(i-1) ancestor
             up[v][i] = up[up[v][i - 1]][i - 1];
             maxWeight[v][i] = std::max(maxWeight[v][i - 1], maxWeight[up[v][i - 1]][i - 1]);
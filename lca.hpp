@@ -4,6 +4,7 @@
 #include "graph.hpp"
 #include <vector>
 #include <set>
+#include <cstddef>
 
 //LCA class to find heaviest edge in path between two nodes in a tree
 //Using Binary Lifting method instructed on GeeksforGeeks
@@ -18,20 +19,25 @@ class LCA {
     explicit LCA(const Graph& F);
 
     //return max edge weight in path between u and v
-    double maxEdgeWeight(int u, int v);
+    Weight maxEdgeWeight(Index u, Index v);
+
+    //approximate footprint in bytes (dominated by the up and maxWeight tables, O(n log n))
+    std::size_t memoryBytes() const;
+    //footprint of an LCA of a forest with n vertices and numEdges edges, before building it
+    static std::size_t memoryEstimate(Index n, std::size_t numEdges);
 
     private:
-    int n;                              //number of nodes in the tree
+    Index n;                              //number of nodes in the tree
     int log;                            //max power of 2
     std::vector<std::vector<Graph::Edge>> adjList {};
-    std::vector<int> parent;                //parent of each node
-    std::vector<int> level;                    //level of each node in the tree (depth)
-    std::vector<std::vector<int>> up;           //up[i][j]: the 2^j-th ancestor of node i
-    std::vector<std::vector<double>> maxWeight; //maxWeight[v][j]: max edge weight from v to its 2^j-th ancestor  
-    std::vector<int> rootID; //store root (component) ID of node
+    std::vector<Index> parent;                //parent of each node
+    std::vector<Index> level;                    //level of each node in the tree (depth)
+    std::vector<std::vector<Index>> up;           //up[i][j]: the 2^j-th ancestor of node i
+    std::vector<std::vector<Weight>> maxWeight; //maxWeight[v][j]: max edge weight from v to its 2^j-th ancestor  
+    std::vector<Index> rootID; //store root (component) ID of node
     //helper functions
     //compute dfs traversal to set parent and level arrays
-    void dfs(int u, int p, int r); //u: node, p: parent of u, r: root of u
+    void dfs(Index u, Index p, Index r); //u: node, p: parent of u, r: root of u
 
     //preprocessing to fill lca and maxWeight tables
     void preprocessing();
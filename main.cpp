@@ -10,9 +10,73 @@
 #include "boruvka.hpp"
 #include "union_find.hpp"
 #include <queue>
+#include <map>
 #include <limits>
 #include "lca.hpp"
 #include "union_find.hpp"
+#include "dynamic_mst.hpp"
+#include "external_mst.hpp"
+#include "clustering.hpp"
+#include "euclidean_mst.hpp"
+#include "boruvka_kernel.hpp"
+#include "reorder.hpp"
+#include "mst_cache.hpp"
+#include "memory_tracker.hpp"
+#include "forest_components.hpp"
+#include "mst_job.hpp"
+#include "sensitivity.hpp"
+#include "bottleneck.hpp"
+#include "spanning_forest.hpp"
+#include "batch_mst.hpp"
+#include "radix_kruskal.hpp"
+#include "numa_mst.hpp"
+#include "approximate_mst.hpp"
+#include "compressed_graph.hpp"
+#include "partitioned_mst.hpp"
+#include "thread_pool.hpp"
+#include "boruvka_hierarchy.hpp"
+#include <array>
+#include <fstream>
+#include <filesystem>
+#include <numeric>
+#include <atomic>
+#include <future>
+#include <set>
+#include <thread>
+#include <tuple>
+#include <type_traits>
+//----------weights of the test graphs---------
+//tests write real weights; integer Weight types (MST_WEIGHT_TYPE) store them scaled by
+//WEIGHT_SCALE and rounded, so weights with up to three decimals keep their order
+constexpr double WEIGHT_SCALE = std::is_integral_v<Weight> ? 1000 : 1;
+
+Weight testWeight(double w) {
+  if constexpr (std::is_integral_v<Weight>) return static_cast<Weight>(std::llround(w * WEIGHT_SCALE));
+  else return static_cast<Weight>(w);
+}
+
+//check a forest weight against the sum of its real test weights: to a few ULPs for double
+//weights, to the precision the weights were stored with otherwise
+void expectWeightSum(WeightSum sum, double expected) {
+  if constexpr (std::is_same_v<Weight, double>) EXPECT_DOUBLE_EQ(sum, expected);
+  else EXPECT_NEAR(sum, expected * WEIGHT_SCALE, 1e-5 * std::abs(expected * WEIGHT_SCALE));
+}
+
+//graph from (real weight, v1, v2) triples
+Graph testGraph(Index n, std::initializer_list<std::tuple<double, Index, Index> > edges) {
+  Graph G {n};
+  for (auto [w, v1, v2] : edges) G.addEdge({testWeight(w), v1, v2});
+  return G;
+}
+
+//tinyEWG from Algorithms by Sedgewick and Wayne, its MST weighs 1.81
+Graph tinyEWG() {
+  return testGraph(8, {{0.35, 4, 5}, {0.37, 4, 7}, {0.28, 5, 7}, {0.16, 0, 7},
+                       {0.32, 1, 5}, {0.38, 0, 4}, {0.17, 2, 3}, {0.19, 1, 7},
+                       {0.26, 0, 2}, {0.36, 1, 2}, {0.29, 1, 3}, {0.34, 2, 7},
+                       {0.40, 6, 2}, {0.52, 3, 6}, {0.58, 6, 0}, {0.93, 6, 4}});
+}
+
 //----------function to check cycle property---------
 bool verifyMST(const Graph& G, const Graph& mst) {
   LCA lca(mst);
@@ -161,12 +225,9 @@ TEST(MstBoruvkaTest, AustralianCities) {
 
 // example test case from Algorithms by Sedgewick and Wayne
 TEST(MstBoruvkaTest, tinyEWG) {
-  Graph G {8, {{0.35, 4, 5}, {0.37, 4, 7}, {0.28, 5, 7}, {0.16, 0, 7},
-               {0.32, 1, 5}, {0.38, 0, 4}, {0.17, 2, 3}, {0.19, 1, 7},
-               {0.26, 0, 2}, {0.36, 1, 2}, {0.29, 1, 3}, {0.34, 2, 7},
-               {0.40, 6, 2}, {0.52, 3, 6}, {0.58, 6, 0}, {0.93, 6, 4}}};
+  Graph G = tinyEWG();
   Graph mst = boruvkaMST(G);
-  EXPECT_DOUBLE_EQ(mst.edgeWeightSum(), 1.81);
+  expectWeightSum(mst.edgeWeightSum(), 1.81);
   /*
   minimum spanning tree should look like this:
   Neighbors of 0: {0,2}[0.26] {0,7}[0.16]
@@ -199,6 +260,7 @@ TEST(MstBoruvkaTest, disconnectedGraphCycleProperty) {
 
 // larger test case from Algorithms by Sedgewick and Wayne
 TEST(MstBoruvkaTest, mediumEWG) {
+  if constexpr (std::is_integral_v<Weight>) GTEST_SKIP() << "mediumEWG.txt has real weights";
   Graph G {"mediumEWG.txt"};
   Graph mst = boruvkaMST(G);
   std::cout << mst.edgeWeightSum();
@@ -223,7 +285,7 @@ Graph randomEuclideanGraph(int N, int numEdges, unsigned seed) {
   for (int i = 0; i < numEdges; ++i) {
     int index1 = indexDist(mt);
     int index2 = indexDist(mt);
-    G.addEdge({euclideanDist(points.at(index1), points.at(index2)),
+    G.addEdge({testWeight(euclideanDist(points.at(index1), points.at(index2))),
                 index1, index2});
   }
   return G;
@@ -392,19 +454,13 @@ TEST(mstKKTTest, AustralianCities) {
 
 // example test case from Algorithms by Sedgewick and Wayne
 TEST(mstKKTTest, tinyEWG) {
-  Graph G {8, {{0.35, 4, 5}, {0.37, 4, 7}, {0.28, 5, 7}, {0.16, 0, 7},
-               {0.32, 1, 5}, {0.38, 0, 4}, {0.17, 2, 3}, {0.19, 1, 7},
-               {0.26, 0, 2}, {0.36, 1, 2}, {0.29, 1, 3}, {0.34, 2, 7},
-               {0.40, 6, 2}, {0.52, 3, 6}, {0.58, 6, 0}, {0.93, 6, 4}}};
+  Graph G = tinyEWG();
   Graph mst = kktMST(G);
-  EXPECT_DOUBLE_EQ(mst.edgeWeightSum(), 1.81);
+  expectWeightSum(mst.edgeWeightSum(), 1.81);
 }
 
 TEST(mstKKTTest, tinyEWGCycleroperty) {
-  Graph G {8, {{0.35, 4, 5}, {0.37, 4, 7}, {0.28, 5, 7}, {0.16, 0, 7},
-               {0.32, 1, 5}, {0.38, 0, 4}, {0.17, 2, 3}, {0.19, 1, 7},
-               {0.26, 0, 2}, {0.36, 1, 2}, {0.29, 1, 3}, {0.34, 2, 7},
-               {0.40, 6, 2}, {0.52, 3, 6}, {0.58, 6, 0}, {0.93, 6, 4}}};
+  Graph G = tinyEWG();
   Graph mst = kktMST(G);
   bool f = verifyMST(G, mst);
   EXPECT_TRUE(f);
@@ -428,6 +484,7 @@ TEST(mstKKTTest, disconnectedGraphCycleroperty) {
 
 // larger test case from Algorithms by Sedgewick and Wayne
 TEST(mstKKTTest, mediumEWG) {
+  if constexpr (std::is_integral_v<Weight>) GTEST_SKIP() << "mediumEWG.txt has real weights";
   Graph G {"mediumEWG.txt"};
   Graph mst = kktMST(G);
   std::cout << mst.edgeWeightSum();
@@ -435,6 +492,7 @@ TEST(mstKKTTest, mediumEWG) {
 }
 
 TEST(mstKKTTest, mediumEWGCycleroperty) {
+  if constexpr (std::is_integral_v<Weight>) GTEST_SKIP() << "mediumEWG.txt has real weights";
   Graph G {"mediumEWG.txt"};
   Graph mst = kktMST(G);
   bool f = verifyMST(G, mst);
@@ -550,6 +608,1610 @@ TEST(mstKKTTest, 100KVertices) {
   EXPECT_NEAR(mst.edgeWeightSum(), mst_res.edgeWeightSum(), 0.00001);
 }
 
+//===========DYNAMIC MST TEST=================
+
+TEST(DynamicMSTTest, EmptyGraph) {
+  DynamicMST dyn(0);
+  EXPECT_DOUBLE_EQ(dyn.totalWeight(), 0);
+  EXPECT_EQ(dyn.numForestEdges(), 0);
+}
+
+TEST(DynamicMSTTest, AustralianCitiesDeleteAndUpdate) {
+  Graph G {7, {{2600, 0, 1}, {3600, 0, 2}, {2800, 1, 3}, {3000, 1, 5},
+               {1400, 2, 3}, {1900, 2, 4}, {900, 3, 4}, {880, 4, 5},
+               {1000, 4, 6}, {700, 5, 6}}};
+  DynamicMST dyn(G);
+  EXPECT_DOUBLE_EQ(dyn.totalWeight(), 9280);
+  EXPECT_TRUE(dyn.inForest(6));     //{3,4}[900]
+  EXPECT_FALSE(dyn.inForest(1));    //{0,2}[3600]
+  //removing {3,4} forces the replacement {2,4}[1900]
+  dyn.deleteEdge(6);
+  EXPECT_FALSE(dyn.hasEdge(6));
+  EXPECT_DOUBLE_EQ(dyn.totalWeight(), 9280 - 900 + 1900);
+  //making {0,2} cheap swaps out {1,3}[2800]
+  dyn.updateWeight(1, 100);
+  EXPECT_TRUE(dyn.inForest(1));
+  EXPECT_FALSE(dyn.inForest(2));
+  EXPECT_DOUBLE_EQ(dyn.totalWeight(), boruvkaMST(dyn.graph()).edgeWeightSum());
+}
+
+TEST(DynamicMSTTest, disconnectedGraph) {
+  DynamicMST dyn(8);
+  int a = dyn.insertEdge(0, 1, 1);
+  dyn.insertEdge(1, 2, 1);
+  dyn.insertEdge(4, 5, 1);
+  EXPECT_EQ(dyn.numForestEdges(), 3);
+  dyn.deleteEdge(a);
+  EXPECT_EQ(dyn.numForestEdges(), 2);
+  EXPECT_DOUBLE_EQ(dyn.totalWeight(), 2.0);
+}
+
+TEST(DynamicMSTTest, randomUpdateSequence) {
+  const int N = 40;
+  std::mt19937 mt {742'117};
+  std::uniform_int_distribution<int> vertexDist {0, N - 1};
+  std::uniform_real_distribution<double> weightDist {0.0, 100.0};
+  std::uniform_int_distribution<int> opDist {0, 9};
+  DynamicMST dyn(randomEuclideanGraph(N, 80, 742'117));
+  std::vector<Index> ids;
+  for (int id = 0; id < 80; ++id) ids.push_back(id);
+  for (int step = 0; step < 2'000; ++step) {
+    int op = opDist(mt);
+    if (op < 4 || ids.empty()) {
+      ids.push_back(dyn.insertEdge(vertexDist(mt), vertexDist(mt), weightDist(mt)));
+    }
+    else if (op < 7) {
+      std::uniform_int_distribution<std::size_t> pick {0, ids.size() - 1};
+      std::size_t k = pick(mt);
+      dyn.deleteEdge(ids[k]);
+      ids[k] = ids.back();
+      ids.pop_back();
+    }
+    else {
+      std::uniform_int_distribution<std::size_t> pick {0, ids.size() - 1};
+      dyn.updateWeight(ids[pick(mt)], weightDist(mt));
+    }
+    if (step % 50 == 0) {
+      Graph G = dyn.graph();
+      Graph mst = boruvkaMST(G);
+      EXPECT_NEAR(dyn.totalWeight(), mst.edgeWeightSum(), 0.00001);
+      EXPECT_NEAR(dyn.forest().edgeWeightSum(), dyn.totalWeight(), 0.00001);
+      EXPECT_TRUE(verifyMST(G, dyn.forest()));
+    }
+  }
+}
+
+//===========SEMI-EXTERNAL MST TEST=================
+
+//sorted edge IDs of a forest, to compare forests edge by edge
+std::vector<Index> forestEdgeIds(const Graph& F) {
+  std::vector<Index> ids;
+  for (int u = 0; u < F.numVertices(); ++u) {
+    for (auto e : *F.neighbours(u)) {
+      if (u == e.v1) ids.push_back(e.edgeId);
+    }
+  }
+  std::sort(ids.begin(), ids.end());
+  return ids;
+}
+
+//write a random graph with distinct real weights in the Graph(inputFile) format
+std::string writeRandomGraphFile(int N, int numEdges, unsigned seed) {
+  std::mt19937 mt {seed};
+  std::uniform_int_distribution<int> indexDist {0, N - 1};
+  std::uniform_real_distribution<double> weightDist {0.0, 1.0};
+  std::string path = (std::filesystem::temp_directory_path() /
+                      ("mst_test_" + std::to_string(seed) + ".txt")).string();
+  std::ofstream out {path};
+  out.precision(17);
+  out << N << '\n';
+  for (int i = 0; i < numEdges; ++i) {
+    out << indexDist(mt) << ' ' << indexDist(mt) << ' ' << testWeight(weightDist(mt)) << '\n';
+  }
+  return path;
+}
+
+TEST(ExternalMSTTest, missingFile) {
+  Graph mst = externalMST("does_not_exist.txt");
+  EXPECT_EQ(mst.numVertices(), 0);
+}
+
+TEST(ExternalMSTTest, mediumEWGInMemory) {
+  if constexpr (std::is_integral_v<Weight>) GTEST_SKIP() << "mediumEWG.txt has real weights";
+  Graph mst = externalMST("mediumEWG.txt");
+  EXPECT_NEAR(mst.edgeWeightSum(), 10.46351, 0.00001);
+  EXPECT_EQ(forestEdgeIds(mst), forestEdgeIds(boruvkaMST(Graph {"mediumEWG.txt"})));
+}
+
+TEST(ExternalMSTTest, randomGraphSortedRuns) {
+  std::string path = writeRandomGraphFile(2'000, 20'000, 617'243);
+  Graph G {path};
+  ExternalOptions options;
+  options.memoryBudget = 128 * 1024;      //several runs, single merge pass
+  Graph mst = externalMST(path, options);
+  EXPECT_EQ(forestEdgeIds(mst), forestEdgeIds(boruvkaMST(G)));
+  std::filesystem::remove(path);
+}
+
+TEST(ExternalMSTTest, randomGraphMultiPassMerge) {
+  std::string path = writeRandomGraphFile(5'000, 40'000, 281'554);
+  Graph G {path};
+  ExternalOptions options;
+  options.memoryBudget = 1;               //smallest buffers: many runs, several merge passes
+  Graph mst = externalMST(path, options);
+  EXPECT_NEAR(mst.edgeWeightSum(), boruvkaMST(G).edgeWeightSum(), 0.00001);
+  EXPECT_EQ(forestEdgeIds(mst), forestEdgeIds(boruvkaMST(G)));
+  std::filesystem::remove(path);
+}
+
+TEST(ExternalMSTTest, concurrentRuns) {
+  //every thread writes its own runs into the same directory
+  std::string path = writeRandomGraphFile(2'000, 20'000, 617'244);
+  std::vector<Index> expected = forestEdgeIds(boruvkaMST(Graph {path}));
+  ExternalOptions options;
+  options.memoryBudget = 16 * 1024;
+  std::vector<std::vector<Index>> results(4);
+  std::vector<std::thread> threads;
+  for (std::size_t t = 0; t < results.size(); ++t) {
+    threads.emplace_back([&, t] { results[t] = forestEdgeIds(externalMST(path, options)); });
+  }
+  for (auto& thread : threads) thread.join();
+  for (const auto& ids : results) EXPECT_EQ(ids, expected);
+  std::filesystem::remove(path);
+}
+
+//===========CLUSTERING TEST=================
+
+TEST(ClusteringTest, EmptyGraph) {
+  Dendrogram D(boruvkaMST(Graph(0)));
+  EXPECT_EQ(D.numVertices(), 0);
+  EXPECT_TRUE(D.cutClusters(1).empty());
+}
+
+TEST(ClusteringTest, AustralianCities) {
+  Graph G {7, {{2600, 0, 1}, {3600, 0, 2}, {2800, 1, 3}, {3000, 1, 5},
+               {1400, 2, 3}, {1900, 2, 4}, {900, 3, 4}, {880, 4, 5},
+               {1000, 4, 6}, {700, 5, 6}}};
+  Dendrogram D(kktMST(G));
+  EXPECT_EQ(D.tree().numNodes(), 13);
+  EXPECT_EQ(D.cutClusters(2), (std::vector<Index> {0, 0, 1, 1, 1, 1, 1}));
+  EXPECT_EQ(D.cutClusters(7), (std::vector<Index> {0, 1, 2, 3, 4, 5, 6}));
+  EXPECT_EQ(D.cutThreshold(1000), (std::vector<Index> {0, 1, 2, 3, 3, 3, 3}));
+  EXPECT_EQ(D.clusterAt(6, 900), D.clusterAt(3, 900));
+  EXPECT_NE(D.clusterAt(6, 900), D.clusterAt(2, 900));
+  EXPECT_EQ(D.clusterSize(D.clusterAt(6, 900)), 4);
+  EXPECT_EQ(D.clusterAt(0, 100), 0);
+}
+
+TEST(ClusteringTest, disconnectedGraph) {
+  Graph G {8, { {1, 0, 1}, {1, 1, 2}, {1, 2, 3}, {1, 4, 5}, {1, 5, 6},
+                {1, 6, 7} }};
+  Dendrogram D(boruvkaMST(G));
+  //two trees can't be cut into a single cluster
+  EXPECT_EQ(D.cutClusters(1), (std::vector<Index> {0, 0, 0, 0, 1, 1, 1, 1}));
+}
+
+TEST(ClusteringTest, randomEuclideanThresholds) {
+  const int N = 250;
+  const int numEdges = 1200;
+  Graph G = randomEuclideanGraph(N, numEdges, 329'823);
+  Dendrogram D(boruvkaMST(G));
+  for (double t : {0.0, 5.0, 20.0, 60.0, 500.0}) {
+    //single linkage at t == connectivity using only edges of weight <= t
+    UnionFind uf(N);
+    for (int u = 0; u < N; ++u) {
+      for (auto e : *G.neighbours(u)) {
+        if (e.weight <= t) uf.merge(e.v1, e.v2);
+      }
+    }
+    std::vector<Index> labels = D.cutThreshold(t);
+    for (int u = 0; u < N; ++u) {
+      for (int v = u + 1; v < N; ++v) {
+        EXPECT_EQ(labels[u] == labels[v], uf.sameSet(u, v));
+        EXPECT_EQ(D.clusterAt(u, t) == D.clusterAt(v, t), uf.sameSet(u, v));
+      }
+    }
+  }
+}
+
+//===========EUCLIDEAN MST TEST=================
+
+//complete graph over the points, only usable for small point sets
+template <std::size_t D>
+Graph completeEuclideanGraph(const std::vector<std::array<double, D> >& points) {
+  int n = static_cast<int>(points.size());
+  Graph G {n};
+  for (int i = 0; i < n; ++i) {
+    for (int j = i + 1; j < n; ++j) {
+      double sum = 0.0;
+      for (std::size_t d = 0; d < D; ++d) {
+        sum += (points[i][d] - points[j][d]) * (points[i][d] - points[j][d]);
+      }
+      G.addEdge({static_cast<Weight>(std::sqrt(sum)), i, j});  //as euclideanMST stores it
+    }
+  }
+  return G;
+}
+
+template <std::size_t D>
+std::vector<std::array<double, D> > randomPoints(int n, double range, unsigned seed) {
+  std::mt19937 mt {seed};
+  std::uniform_real_distribution<double> coordDist {0.0, range};
+  std::vector<std::array<double, D> > points(n);
+  for (auto& p : points) {
+    for (auto& x : p) x = coordDist(mt);
+  }
+  return points;
+}
+
+TEST(EuclideanMSTTest, EmptyAndSinglePoint) {
+  EXPECT_EQ(euclideanMST(std::vector<std::array<double, 2> > {}).numVertices(), 0);
+  Graph mst = euclideanMST(std::vector<std::array<double, 2> > {{1.0, 2.0}});
+  EXPECT_EQ(mst.numVertices(), 1);
+  EXPECT_DOUBLE_EQ(mst.edgeWeightSum(), 0);
+}
+
+TEST(EuclideanMSTTest, random2D) {
+  auto points = randomPoints<2>(300, 1000.0, 553'109);
+  Graph mst = euclideanMST(points);
+  EXPECT_NEAR(mst.edgeWeightSum(), boruvkaMST(completeEuclideanGraph(points)).edgeWeightSum(), 0.00001);
+}
+
+TEST(EuclideanMSTTest, random3D) {
+  auto points = randomPoints<3>(300, 1000.0, 120'447);
+  Graph mst = euclideanMST(points);
+  EXPECT_NEAR(mst.edgeWeightSum(), boruvkaMST(completeEuclideanGraph(points)).edgeWeightSum(), 0.00001);
+}
+
+TEST(EuclideanMSTTest, integerGridWithTies) {
+  //many equal distances and duplicate points
+  std::vector<std::array<double, 2> > points;
+  for (int x = 0; x < 12; ++x) {
+    for (int y = 0; y < 12; ++y) points.push_back({double(x), double(y)});
+  }
+  points.push_back({3.0, 3.0});
+  Graph mst = euclideanMST(points);
+  EXPECT_DOUBLE_EQ(mst.edgeWeightSum(), 143.0);
+  EXPECT_TRUE(verifyMST(completeEuclideanGraph(points), mst));
+}
+
+//sorted endpoint pairs of a forest
+std::vector<std::pair<int, int> > forestEndpoints(const Graph& F) {
+  std::vector<std::pair<int, int> > pairs;
+  for (int u = 0; u < F.numVertices(); ++u) {
+    for (auto e : *F.neighbours(u)) {
+      if (u == e.v1) pairs.push_back({std::min(e.v1, e.v2), std::max(e.v1, e.v2)});
+    }
+  }
+  std::sort(pairs.begin(), pairs.end());
+  return pairs;
+}
+
+TEST(EuclideanMSTTest, sameForestForAnyThreadCount) {
+  auto points = randomPoints<2>(5'000, 100.0, 77'001);
+  auto edges1 = forestEndpoints(euclideanMST(points, 1));
+  EXPECT_EQ(forestEndpoints(euclideanMST(points, 4)), edges1);
+  EXPECT_EQ(static_cast<int>(edges1.size()), 4'999);
+}
+
+//===========BORUVKA KERNEL TEST=================
+
+TEST(BoruvkaKernelTest, scanDropsInternalEdges) {
+  Graph G {4, {{3, 0, 1}, {1, 1, 2}, {2, 2, 3}, {5, 0, 0}, {4, 0, 3}}};
+  EdgeArrays E(G);
+  EXPECT_EQ(E.size(), 4);                      //no self-loop
+  std::vector<Index> label {0, 1, 1, 3};      //1 and 2 already merged
+  std::vector<Index> cheapest;
+  boruvkaScan(E, label, cheapest);
+  EXPECT_EQ(E.size(), 3);                      //{1,2} is gone
+  EXPECT_DOUBLE_EQ(E.edge(cheapest[0]).weight, 3);
+  EXPECT_DOUBLE_EQ(E.edge(cheapest[1]).weight, 2);
+  EXPECT_DOUBLE_EQ(E.edge(cheapest[3]).weight, 2);
+  EXPECT_EQ(cheapest[2], -1);
+}
+
+TEST(BoruvkaKernelTest, sameForestForEveryKernel) {
+  BoruvkaKernel original = boruvkaKernel();
+  //integer coordinates give many equal weights
+  Graph G = randomEuclideanGraph(1000, 15'000, 11'829'119);
+  setBoruvkaKernel(BoruvkaKernel::Scalar);
+  std::vector<Index> expected = forestEdgeIds(boruvkaMST(G));
+  for (auto kernel : {BoruvkaKernel::AVX2, BoruvkaKernel::AVX512}) {
+    setBoruvkaKernel(kernel);
+    EXPECT_EQ(forestEdgeIds(boruvkaMST(G)), expected);
+    EXPECT_TRUE(verifyMST(G, kktMST(G)));
+  }
+  setBoruvkaKernel(original);
+}
+
+//===========VERTEX REORDERING TEST=================
+
+//random graph with distinct real weights, a spanning path keeps it connected
+//(integer weights are drawn below 10^9, so they stay distinct too)
+Graph randomDistinctWeightGraph(int N, int numEdges, unsigned seed) {
+  std::mt19937 mt {seed};
+  std::uniform_int_distribution<int> indexDist {0, N - 1};
+  std::uniform_real_distribution<double> weightDist {0.0, std::is_integral_v<Weight> ? 1e6 : 1.0};
+  Graph G {N};
+  for (int v = 1; v < N; ++v) G.addEdge({testWeight(weightDist(mt)), v - 1, v});
+  for (int i = N - 1; i < numEdges; ++i) {
+    G.addEdge({testWeight(weightDist(mt)), indexDist(mt), indexDist(mt)});
+  }
+  return G;
+}
+
+bool isPermutation(std::vector<Index> perm) {
+  std::sort(perm.begin(), perm.end());
+  for (int i = 0; i < static_cast<int>(perm.size()); ++i) {
+    if (perm[i] != i) return false;
+  }
+  return true;
+}
+
+TEST(ReorderTest, sameForestInOriginalIds) {
+  Graph G = randomDistinctWeightGraph(2'000, 10'000, 640'221);
+  std::vector<Index> expected = forestEdgeIds(boruvkaMST(G));
+  for (auto order : {VertexOrder::BFS, VertexOrder::RCM, VertexOrder::Degree}) {
+    ReorderedGraph R = reorderGraph(G, order);
+    EXPECT_TRUE(isPermutation(R.newToOld));
+    for (int v = 0; v < G.numVertices(); ++v) EXPECT_EQ(R.newToOld[R.oldToNew[v]], v);
+    EXPECT_NEAR(R.graph.edgeWeightSum(), G.edgeWeightSum(), 1e-6);
+    Graph viaBoruvka = reorderedMST(G, order, [](const Graph& H) { return boruvkaMST(H); });
+    Graph viaKKT = reorderedMST(G, order, [](const Graph& H) { return kktMST(H); });
+    EXPECT_EQ(forestEdgeIds(viaBoruvka), expected);
+    EXPECT_EQ(forestEdgeIds(viaKKT), expected);
+    EXPECT_TRUE(verifyMST(G, viaKKT));
+  }
+}
+
+TEST(ReorderTest, RCMShuffledPath) {
+  const int N = 500;
+  std::vector<Index> label(N);
+  std::iota(label.begin(), label.end(), 0);
+  std::shuffle(label.begin(), label.end(), std::mt19937 {3'318});
+  Graph G {N};
+  for (int i = 1; i < N; ++i) G.addEdge({static_cast<Weight>(i), label[i - 1], label[i]});
+  Graph H = reorderGraph(G, VertexOrder::RCM).graph;
+  Index bandwidth = 0;
+  for (int u = 0; u < N; ++u) {
+    for (auto e : *H.neighbours(u)) bandwidth = std::max(bandwidth, std::abs(e.v1 - e.v2));
+  }
+  EXPECT_EQ(bandwidth, 1);
+}
+
+TEST(ReorderTest, HilbertGrid) {
+  //4 x 4 grid with shuffled labels, consecutive Hilbert positions are grid neighbours
+  const int side = 4;
+  std::vector<Index> label(side * side);
+  std::iota(label.begin(), label.end(), 0);
+  std::shuffle(label.begin(), label.end(), std::mt19937 {12});
+  std::vector<std::array<double, 2> > coords(side * side);
+  Graph G {side * side};
+  for (int x = 0; x < side; ++x) {
+    for (int y = 0; y < side; ++y) {
+      coords[label[x * side + y]] = {1.0 * x, 1.0 * y};
+      if (x > 0) G.addEdge({1, label[(x - 1) * side + y], label[x * side + y]});
+      if (y > 0) G.addEdge({1, label[x * side + y - 1], label[x * side + y]});
+    }
+  }
+  ReorderedGraph R = reorderGraph(G, coords);
+  EXPECT_TRUE(isPermutation(R.newToOld));
+  for (int v = 1; v < side * side; ++v) {
+    auto a = coords[R.newToOld[v - 1]];
+    auto b = coords[R.newToOld[v]];
+    EXPECT_DOUBLE_EQ(std::abs(a[0] - b[0]) + std::abs(a[1] - b[1]), 1.0);
+  }
+  EXPECT_EQ(forestEdgeIds(restoreOriginalIds(R, boruvkaMST(R.graph))).size(), 15u);
+  //without coordinates there is no Hilbert order
+  EXPECT_THROW(reorderGraph(G, VertexOrder::Hilbert), std::invalid_argument);
+}
+
+//===========BULK GRAPH CONSTRUCTION TEST=================
+
+TEST(GraphBulkTest, sameAsAddEdge) {
+  //invalid endpoints, self-loops, given and missing IDs, a repeated ID
+  std::vector<Graph::Edge> edges {{1, 0, 1}, {2, 1, 2, 7}, {3, 2, 2}, {4, 0, 5},
+                                  {5, -1, 2}, {6, 3, 0}, {7, 1, 3, 7}, {8, 2, 3, 2}};
+  std::mt19937 mt {4'242};
+  std::uniform_int_distribution<int> indexDist {0, 3};
+  for (int i = 0; i < 1'000; ++i) edges.push_back({static_cast<Weight>(i), indexDist(mt), indexDist(mt)});
+  Graph single {4};
+  for (const auto& e : edges) single.addEdge(e);
+  Graph bulk {4, edges};
+  Graph appended {4, {edges.begin(), edges.begin() + 3}};
+  appended.addEdges({edges.begin() + 3, edges.end()});
+  for (int u = 0; u < 4; ++u) {
+    EXPECT_EQ(*bulk.neighbours(u), *single.neighbours(u));
+    EXPECT_EQ(*appended.neighbours(u), *single.neighbours(u));
+  }
+  for (auto id : {0, 7, 8, 9, 50}) {
+    EXPECT_EQ(bulk.edgeByID(id), single.edgeByID(id));
+  }
+  EXPECT_EQ(bulk.edgeByID(7).v1, 1);          //first edge with an ID is the original
+}
+
+TEST(GraphBulkTest, largeGraph) {
+  //several threads fill the lists (the pool size applies when ctest runs the test on its own)
+  setGlobalThreadPoolSize(4);
+  const int N = 50'000;
+  const int numEdges = 600'000;
+  std::mt19937 mt {8'080};
+  std::uniform_int_distribution<int> indexDist {0, N - 1};
+  std::vector<Graph::Edge> edges(numEdges);
+  for (auto& e : edges) e = {static_cast<Weight>(indexDist(mt)), indexDist(mt), indexDist(mt)};
+  Graph single {N};
+  for (const auto& e : edges) single.addEdge(e);
+  Graph bulk {N, std::move(edges)};
+  for (int u = 0; u < N; ++u) {
+    ASSERT_EQ(*bulk.neighbours(u), *single.neighbours(u));
+    EXPECT_EQ(bulk.neighbours(u)->capacity(), bulk.neighbours(u)->size());
+  }
+}
+
+//===========DETERMINISTIC TIE-BREAKING TEST=================
+
+//Kruskal in the (weight, edge ID) order, the unique minimum spanning forest
+Graph kruskalTotalOrder(const Graph& G) {
+  std::vector<Graph::Edge> edges;
+  for (int u = 0; u < G.numVertices(); ++u) {
+    for (auto e : *G.neighbours(u)) {
+      if (u == e.v1) edges.push_back(e);
+    }
+  }
+  std::sort(edges.begin(), edges.end(), lighterEdge);
+  UnionFind uf(G.numVertices());
+  std::vector<Graph::Edge> forest;
+  for (auto e : edges) {
+    if (uf.sameSet(e.v1, e.v2)) continue;
+    uf.merge(e.v1, e.v2);
+    forest.push_back(e);
+  }
+  return canonicalForm(Graph(G.numVertices(), forest));
+}
+
+//write G in the Graph(inputFile) format, edges in ID order so IDs are kept
+std::string writeGraphFile(const Graph& G, const std::string& name) {
+  std::string path = (std::filesystem::temp_directory_path() / name).string();
+  std::ofstream out {path};
+  out.precision(17);
+  out << G.numVertices() << '\n';
+  std::vector<Graph::Edge> edges;
+  for (int u = 0; u < G.numVertices(); ++u) {
+    for (auto e : *G.neighbours(u)) {
+      //a self-loop is listed twice, write it once
+      if (u == e.v1 && (edges.empty() || edges.back().edgeId != e.edgeId)) edges.push_back(e);
+    }
+  }
+  std::sort(edges.begin(), edges.end(), [](auto a, auto b) { return a.edgeId < b.edgeId; });
+  for (auto e : edges) out << e.v1 << ' ' << e.v2 << ' ' << e.weight << '\n';
+  return path;
+}
+
+//every engine returns the same forest, compared in canonical form
+void expectSameForestEverywhere(const Graph& G, const std::string& name) {
+  Graph expected = kruskalTotalOrder(G);
+  EXPECT_TRUE(canonicalForm(boruvkaMST(G)) == expected);
+  for (int run = 0; run < 3; ++run) {
+    EXPECT_TRUE(canonicalForm(kktMST(G)) == expected);      //random sampling inside
+  }
+  BoruvkaKernel original = boruvkaKernel();
+  for (auto kernel : {BoruvkaKernel::Scalar, BoruvkaKernel::AVX2, BoruvkaKernel::AVX512}) {
+    setBoruvkaKernel(kernel);
+    EXPECT_TRUE(canonicalForm(boruvkaMST(G)) == expected);
+  }
+  setBoruvkaKernel(original);
+  EXPECT_TRUE(canonicalForm(DynamicMST(G).forest()) == expected);
+  auto engine = [](const Graph& H) { return kktMST(H); };
+  EXPECT_TRUE(canonicalForm(reorderedMST(G, VertexOrder::RCM, engine)) == expected);
+  std::string path = writeGraphFile(G, name);
+  ExternalOptions options;
+  options.memoryBudget = 64 * sizeof(Graph::Edge);          //many runs
+  EXPECT_TRUE(canonicalForm(externalMST(path, options)) == expected);
+  std::filesystem::remove(path);
+}
+
+TEST(DeterminismTest, allEdgesSameWeight) {
+  Graph G{7, {{5, 0,1}, {5, 0, 2}, {5, 1, 3}, {5, 1, 5}, {5, 2, 3}, {5, 2, 4}, {5, 3, 4},
+              {5, 4, 5}, {880, 4, 5}, {5, 4, 6}, {5, 5, 6}}};
+  Graph mst = boruvkaMST(G);
+  EXPECT_EQ(forestEdgeIds(mst), (std::vector<Index> {0, 1, 2, 3, 5, 9}));
+  expectSameForestEverywhere(G, "mst_same_weight.txt");
+}
+
+TEST(DeterminismTest, equalWeightGridAndRandomTies) {
+  //unit-weight grid: every spanning tree is minimum
+  const int side = 40;
+  Graph grid {side * side};
+  for (int x = 0; x < side; ++x) {
+    for (int y = 0; y < side; ++y) {
+      if (x > 0) grid.addEdge({1, (x - 1) * side + y, x * side + y});
+      if (y > 0) grid.addEdge({1, x * side + y - 1, x * side + y});
+    }
+  }
+  Graph mst = boruvkaMST(grid);
+  EXPECT_EQ(forestEdgeIds(mst).size(), static_cast<std::size_t>(side * side - 1));
+  expectSameForestEverywhere(grid, "mst_unit_grid.txt");
+  //integer coordinates, many equal distances, some vertices left isolated
+  expectSameForestEverywhere(randomEuclideanGraph(3'000, 8'000, 5'150), "mst_random_ties.txt");
+}
+
+TEST(DeterminismTest, zeroAndMixedSignWeights) {
+  //weights summing to 0 are a normal input, not an empty graph
+  Graph zeroCycle {4, {{0, 0, 1}, {0, 1, 2}, {0, 2, 3}, {0, 3, 0}}};
+  Graph signedPath {3, {{-1, 0, 1}, {1, 1, 2}}};
+  for (const Graph* G : {&zeroCycle, &signedPath}) {
+    std::vector<Index> expected = forestEdgeIds(kruskalTotalOrder(*G));
+    EXPECT_EQ(expected.size(), static_cast<std::size_t>(G->numVertices() - 1));
+    EXPECT_EQ(kktSpanningForest(*G).edgeIds(), expected);
+    EXPECT_EQ(radixKruskalForest(*G).edgeIds(), expected);
+  }
+  expectSameForestEverywhere(zeroCycle, "mst_zero_cycle.txt");
+  expectSameForestEverywhere(signedPath, "mst_signed_path.txt");
+  //random -1 / 0 / +1 weights: many ties, weight sums near 0
+  std::mt19937 mt {2'024};
+  std::uniform_int_distribution<int> indexDist {0, 499};
+  std::uniform_int_distribution<int> weightDist {-1, 1};
+  Graph mixed {500};
+  for (int i = 0; i < 2'000; ++i) mixed.addEdge({static_cast<Weight>(weightDist(mt)), indexDist(mt), indexDist(mt)});
+  expectSameForestEverywhere(mixed, "mst_mixed_sign.txt");
+}
+
+TEST(DeterminismTest, canonicalFormIsBitIdentical) {
+  Graph G = randomEuclideanGraph(500, 3'000, 991);
+  Graph a = canonicalForm(kktMST(G));
+  Graph b = canonicalForm(boruvkaMST(G));
+  EXPECT_TRUE(a == b);
+  EXPECT_TRUE(canonicalForm(a) == a);
+  //Euclidean MST on a grid of points (all ties) for any thread count
+  std::vector<std::array<double, 2> > points;
+  for (int x = 0; x < 30; ++x) {
+    for (int y = 0; y < 30; ++y) points.push_back({1.0 * x, 1.0 * y});
+  }
+  Graph expected = euclideanMST(points, 1);
+  for (int threads : {2, 3, 8}) {
+    EXPECT_TRUE(euclideanMST(points, threads) == expected);
+  }
+}
+
+//===========MST CACHE TEST=================
+
+//G's edges in shuffled order (new IDs), endpoints swapped, plus padding isolated vertices
+Graph shuffledCopy(const Graph& G, unsigned seed, int padding) {
+  std::vector<Graph::Edge> edges;
+  int lastSelfLoop = -1;
+  for (int u = 0; u < G.numVertices(); ++u) {
+    for (auto e : *G.neighbours(u)) {
+      if (u != e.v1 || e.edgeId == lastSelfLoop) continue;      //a self-loop is listed twice
+      if (e.v1 == e.v2) lastSelfLoop = e.edgeId;
+      edges.push_back({e.weight, e.v2, e.v1});
+    }
+  }
+  std::shuffle(edges.begin(), edges.end(), std::mt19937 {seed});
+  return Graph(G.numVertices() + padding, edges);
+}
+
+TEST(MSTCacheTest, fingerprintIgnoresOrderAndPadding) {
+  Graph G = randomDistinctWeightGraph(40'000, 200'000, 7'123);
+  std::uint64_t fp = graphFingerprint(G, 1);
+  EXPECT_EQ(graphFingerprint(G, 4), fp);
+  EXPECT_EQ(graphFingerprint(shuffledCopy(G, 5, 0)), fp);
+  EXPECT_EQ(graphFingerprint(shuffledCopy(G, 6, 100)), fp);
+  Graph H = G;
+  H.addEdge({5, 0, 1});
+  EXPECT_NE(graphFingerprint(H), fp);
+  EXPECT_NE(graphFingerprint(Graph {3, {{1, 0, 1}}}), graphFingerprint(Graph {3, {{1, 0, 2}}}));
+  EXPECT_NE(graphFingerprint(Graph {3, {{1, 0, 1}}}), graphFingerprint(Graph {3, {{2, 0, 1}}}));
+}
+
+TEST(MSTCacheTest, hitsMissesAndEviction) {
+  Graph A = randomDistinctWeightGraph(1'000, 5'000, 1);
+  Graph B = randomDistinctWeightGraph(1'000, 5'000, 2);
+  Graph C = randomDistinctWeightGraph(1'000, 5'000, 3);
+  int engineCalls = 0;
+  MSTCache cache(2, [&engineCalls](const Graph& G) { ++engineCalls; return kktMST(G); });
+  Graph expected = canonicalForm(boruvkaMST(A));
+  EXPECT_TRUE(canonicalForm(cache.get(A)) == expected);
+  EXPECT_TRUE(canonicalForm(cache.get(A)) == expected);
+  EXPECT_EQ(cache.hits(), 1u);
+  EXPECT_EQ(cache.misses(), 1u);
+  cache.get(B);
+  cache.get(A);                           //A is now the most recently used
+  cache.get(C);                           //evicts B
+  EXPECT_EQ(cache.size(), 2u);
+  EXPECT_TRUE(cache.contains(A));
+  EXPECT_FALSE(cache.contains(B));
+  EXPECT_TRUE(cache.contains(C));
+  EXPECT_EQ(engineCalls, 3);
+  //same edges in another order and with padding: hit, IDs refer to the new graph
+  Graph shuffled = shuffledCopy(A, 99, 10);
+  Graph F = cache.get(shuffled);
+  EXPECT_EQ(cache.hits(), 3u);
+  EXPECT_EQ(F.numVertices(), 1'010);
+  EXPECT_TRUE(canonicalForm(F) == canonicalForm(boruvkaMST(shuffled)));
+  for (int u = 0; u < F.numVertices(); ++u) {
+    for (auto e : *F.neighbours(u)) EXPECT_EQ(shuffled.edgeByID(e.edgeId), e);
+  }
+}
+
+TEST(MSTCacheTest, saveAndLoad) {
+  Graph A = randomDistinctWeightGraph(2'000, 9'000, 11);
+  Graph B = randomDistinctWeightGraph(500, 2'000, 12);
+  MSTCache cache(4);
+  cache.get(A);
+  cache.get(B);
+  std::string path = (std::filesystem::temp_directory_path() / "mst_cache_test.bin").string();
+  ASSERT_TRUE(cache.save(path));
+  MSTCache restored(4);
+  ASSERT_TRUE(restored.load(path));
+  EXPECT_EQ(restored.size(), 2u);
+  EXPECT_TRUE(canonicalForm(restored.get(A)) == canonicalForm(boruvkaMST(A)));
+  EXPECT_TRUE(canonicalForm(restored.get(B)) == canonicalForm(boruvkaMST(B)));
+  EXPECT_EQ(restored.hits(), 2u);
+  EXPECT_EQ(restored.misses(), 0u);
+  //a colliding entry (same fingerprint, a forest edge not in the graph) is a miss, not an error
+  MSTCache single(1);
+  single.get(B);
+  ASSERT_TRUE(single.save(path));
+  {
+    //the file ends with the last forest edge: weight, v1, v2, ID
+    std::fstream file {path, std::ios::binary | std::ios::in | std::ios::out};
+    file.seekp(-static_cast<std::streamoff>(sizeof(Weight) + 3 * sizeof(Index)), std::ios::end);
+    Weight foreign = -1'000;
+    file.write(reinterpret_cast<const char*>(&foreign), sizeof(Weight));
+  }
+  MSTCache colliding(1);
+  ASSERT_TRUE(colliding.load(path));
+  ASSERT_TRUE(colliding.contains(B));
+  EXPECT_TRUE(canonicalForm(colliding.get(B)) == canonicalForm(boruvkaMST(B)));
+  EXPECT_EQ(colliding.misses(), 1u);
+  EXPECT_TRUE(canonicalForm(colliding.get(B)) == canonicalForm(boruvkaMST(B)));
+  EXPECT_EQ(colliding.hits(), 1u);
+  //truncated file: rejected, cache unchanged
+  std::filesystem::resize_file(path, std::filesystem::file_size(path) / 2);
+  MSTCache broken(4);
+  EXPECT_FALSE(broken.load(path));
+  EXPECT_EQ(broken.size(), 0u);
+  std::filesystem::remove(path);
+}
+
+//===========MEMORY ACCOUNTING TEST=================
+
+TEST(MemoryTest, structureFootprints) {
+  Graph small = randomDistinctWeightGraph(1'000, 2'000, 31);
+  Graph large = randomDistinctWeightGraph(1'000, 20'000, 31);
+  EXPECT_GT(small.memoryBytes(), 2'000 * 2 * sizeof(Graph::Edge));
+  EXPECT_GT(large.memoryBytes(), 5 * small.memoryBytes());
+  EXPECT_GE(UnionFind(1'000).memoryBytes(), 1'000 * (2 * sizeof(Index) + sizeof(int)));
+  //binary lifting tables: at least n * log n entries
+  Graph forest = boruvkaMST(small);
+  LCA lca(forest);
+  EXPECT_GT(lca.memoryBytes(), 1'000 * 10 * (sizeof(Index) + sizeof(Weight)));
+  //the estimates KKT charges before allocating cover what is then built
+  EXPECT_GE(Graph::memoryEstimate(1'000, 2'000), small.memoryBytes());
+  EXPECT_GE(Graph::memoryEstimate(1'000, 20'000), large.memoryBytes());
+  EXPECT_GE(LCA::memoryEstimate(1'000, 999), lca.memoryBytes());
+}
+
+TEST(MemoryTest, trackerPhasesAndCharges) {
+  MemoryTracker tracker;
+  {
+    MemoryPhase outer(&tracker, "outer");
+    MemoryCharge a(&tracker, 100);
+    {
+      MemoryPhase inner(&tracker, "inner");
+      MemoryCharge b(&tracker, 50);
+      EXPECT_EQ(tracker.current(), 150u);
+    }
+    MemoryCharge c(&tracker, 20);
+    EXPECT_EQ(tracker.current(), 120u);
+  }
+  EXPECT_EQ(tracker.current(), 0u);
+  EXPECT_EQ(tracker.peak(), 150u);
+  ASSERT_EQ(tracker.phasePeaks().size(), 2u);
+  EXPECT_EQ(tracker.phasePeaks()[0], (std::pair<std::string, std::size_t> {"outer", 120}));
+  EXPECT_EQ(tracker.phasePeaks()[1], (std::pair<std::string, std::size_t> {"inner", 150}));
+  MemoryTracker limited(100);
+  MemoryCharge fits(&limited, 60);
+  EXPECT_THROW(MemoryCharge(&limited, 41), MemoryBudgetError);
+  EXPECT_EQ(limited.current(), 60u);
+  MemoryCharge none(nullptr, 1'000);             //no tracker: nothing recorded
+}
+
+TEST(MemoryTest, kktPeakAndBudget) {
+  Graph G = randomDistinctWeightGraph(5'000, 40'000, 1'234);
+  Graph expected = canonicalForm(boruvkaMST(G));
+  MemoryTracker unlimited;
+  EXPECT_TRUE(canonicalForm(kktMST(G, &unlimited)) == expected);
+  EXPECT_EQ(unlimited.current(), 0u);
+  std::size_t kktPeak = unlimited.peak();
+  std::size_t boruvkaNeed = boruvkaMemoryEstimate(G);
+  EXPECT_GT(kktPeak, boruvkaNeed);
+  EXPECT_GE(unlimited.phasePeaks().size(), 3u);
+  //between Boruvka's and KKT's needs: falls back, or fails if asked to
+  MemoryTracker tight((kktPeak + boruvkaNeed) / 2);
+  EXPECT_TRUE(canonicalForm(budgetedMST(G, tight)) == expected);
+  EXPECT_EQ(tight.current(), 0u);
+  EXPECT_LE(tight.peak(), tight.budget());
+  MemoryTracker strict((kktPeak + boruvkaNeed) / 2);
+  EXPECT_THROW(budgetedMST(G, strict, OnBudgetExceeded::Fail), MemoryBudgetError);
+  //not even Boruvka fits: fail before doing any work
+  MemoryTracker tiny(boruvkaNeed / 2);
+  EXPECT_THROW(budgetedMST(G, tiny), MemoryBudgetError);
+  EXPECT_EQ(tiny.peak(), 0u);
+}
+
+//===========FOREST COMPONENTS TEST=================
+
+TEST(ForestComponentsTest, disconnectedGraph) {
+  //components {0,1,2}, {3,4}, {5}, {6,7}
+  Graph G {8, {{4, 0, 1}, {2, 1, 2}, {7, 0, 2}, {1, 3, 4}, {9, 6, 7}, {3, 7, 6}}};
+  ForestComponents C;
+  Graph mst = boruvkaMST(G, C);
+  ASSERT_EQ(C.numComponents(), 4);
+  EXPECT_EQ(C.label, (std::vector<Index> {0, 0, 0, 1, 1, 2, 3, 3}));
+  EXPECT_EQ(C.size, (std::vector<Index> {3, 2, 1, 2}));
+  EXPECT_EQ(C.weight, (std::vector<WeightSum> {6, 1, 0, 3}));
+  EXPECT_EQ(C.edges[0].size(), 2u);
+  EXPECT_TRUE(C.edges[2].empty());
+  EXPECT_EQ(C.edges[3], (std::vector<Graph::Edge> {{3, 7, 6, 5}}));
+  for (auto e : C.edges[1]) EXPECT_EQ(e.edgeId, 3);
+}
+
+TEST(ForestComponentsTest, sameForEveryEngine) {
+  //many isolated vertices and small trees, all-zero weights, weights of both signs
+  Graph zeroCycle {4, {{0, 0, 1}, {0, 1, 2}, {0, 2, 3}, {0, 3, 0}}};
+  Graph signedPath {3, {{-1, 0, 1}, {1, 1, 2}}};
+  for (const Graph& G : {randomEuclideanGraph(3'000, 2'000, 64'646), zeroCycle, signedPath}) {
+    ForestComponents expected = forestComponents(boruvkaMST(G));
+    auto check = [&expected](const ForestComponents& C) {
+      EXPECT_EQ(C.label, expected.label);
+      EXPECT_EQ(C.size, expected.size);
+      ASSERT_EQ(C.numComponents(), expected.numComponents());
+      for (Index c = 0; c < C.numComponents(); ++c) {
+        EXPECT_NEAR(C.weight[c], expected.weight[c], 1e-9);
+        EXPECT_EQ(C.edges[c].size(), static_cast<std::size_t>(C.size[c] - 1));
+      }
+    };
+    ForestComponents fromBoruvka;
+    boruvkaMST(G, fromBoruvka);
+    check(fromBoruvka);
+    ForestComponents fromKKT;
+    kktMST(G, fromKKT);
+    check(fromKKT);
+    std::string path = writeGraphFile(G, "mst_components.txt");
+    ForestComponents fromExternal;
+    externalMST(path, fromExternal, ExternalOptions {64 * sizeof(Graph::Edge)});
+    check(fromExternal);
+    std::filesystem::remove(path);
+  }
+  UnionFind uf(4);
+  uf.merge(0, 1);
+  uf.merge(2, 1);
+  EXPECT_EQ(uf.size(0), 3);
+  EXPECT_EQ(uf.size(3), 1);
+}
+
+//===========ASYNC MST JOB TEST=================
+
+TEST(MSTJobTest, progressAndSyncCancellation) {
+  Graph G = randomDistinctWeightGraph(5'000, 30'000, 8'118);
+  std::vector<Index> remaining;
+  MSTControl watch([&remaining](const MSTProgress& p) { remaining.push_back(p.components); });
+  EXPECT_TRUE(canonicalForm(boruvkaMST(G, watch)) == canonicalForm(boruvkaMST(G)));
+  ASSERT_GE(remaining.size(), 2u);
+  EXPECT_EQ(remaining.front(), 5'000);
+  EXPECT_TRUE(std::is_sorted(remaining.rbegin(), remaining.rend()));
+  int maxDepth = 0;
+  MSTControl depths([&maxDepth](const MSTProgress& p) { maxDepth = std::max(maxDepth, p.depth); });
+  EXPECT_TRUE(canonicalForm(kktMST(G, depths)) == canonicalForm(boruvkaMST(G)));
+  EXPECT_GT(maxDepth, 1);
+  //cancel from inside the second checkpoint
+  int calls = 0;
+  MSTControl* self = nullptr;
+  MSTControl cancelling([&calls, &self](const MSTProgress&) { if (++calls == 2) self->cancel(); });
+  self = &cancelling;
+  EXPECT_THROW(boruvkaMST(G, cancelling), MSTCancelled);
+  EXPECT_EQ(calls, 2);
+  MSTControl stopped;
+  stopped.cancel();
+  EXPECT_THROW(kktMST(G, stopped), MSTCancelled);
+}
+
+TEST(MSTJobTest, jobsOnSharedExecutor) {
+  MSTExecutor executor(2);
+  std::vector<Graph> graphs;
+  std::vector<MSTJob> jobs;
+  for (unsigned seed = 0; seed < 6; ++seed) {
+    graphs.push_back(randomDistinctWeightGraph(2'000, 10'000, seed));
+    MSTEngine engine = (seed % 2) ? MSTEngine::KKT : MSTEngine::Boruvka;
+    jobs.push_back(submitMST(graphs.back(), engine, {}, executor));
+  }
+  for (std::size_t i = 0; i < jobs.size(); ++i) {
+    EXPECT_TRUE(canonicalForm(jobs[i].get()) == canonicalForm(boruvkaMST(graphs[i])));
+    EXPECT_TRUE(jobs[i].ready());
+  }
+  MSTJob shared = submitMST(std::make_shared<const Graph>(graphs[0]), MSTEngine::Boruvka);
+  EXPECT_EQ(forestEdgeIds(shared.get()), forestEdgeIds(boruvkaMST(graphs[0])));
+}
+
+TEST(MSTJobTest, cancelRunningAndQueuedJobs) {
+  MSTExecutor executor(1);
+  Graph G = randomDistinctWeightGraph(20'000, 100'000, 4'004);
+  //the first job holds the only worker at its first checkpoint until cancelled
+  std::promise<void> started;
+  std::promise<void> cancelled;
+  std::shared_future<void> cancelledSignal = cancelled.get_future().share();
+  std::atomic<bool> first {true};
+  MSTJob running = submitMST(G, MSTEngine::Boruvka, [&](const MSTProgress&) {
+    if (!first.exchange(false)) return;
+    started.set_value();
+    cancelledSignal.wait();
+  }, executor);
+  int queuedCalls = 0;
+  MSTJob queued = submitMST(G, MSTEngine::KKT, [&queuedCalls](const MSTProgress&) { ++queuedCalls; },
+                            executor);
+  started.get_future().wait();
+  queued.cancel();
+  running.cancel();
+  cancelled.set_value();
+  EXPECT_THROW(running.get(), MSTCancelled);
+  EXPECT_THROW(queued.get(), MSTCancelled);
+  EXPECT_EQ(queuedCalls, 0);                 //never started
+}
+
+//===========SENSITIVITY ANALYSIS TEST=================
+
+TEST(SensitivityTest, matchesBruteForce) {
+  const int N = 80;
+  Graph G = randomDistinctWeightGraph(N, 400, 3'909);
+  G.addEdge({5, 7, 7});
+  Graph mst = boruvkaMST(G);
+  std::vector<EdgeSensitivity> result = sensitivityAnalysis(G, mst);
+  std::vector<Index> treeIds = forestEdgeIds(mst);
+  std::vector<Graph::Edge> edges;
+  for (int u = 0; u < N; ++u) {
+    for (auto e : *G.neighbours(u)) {
+      if (u == e.v1 && (edges.empty() || edges.back().edgeId != e.edgeId)) edges.push_back(e);
+    }
+  }
+  std::sort(edges.begin(), edges.end(), [](auto a, auto b) { return a.edgeId < b.edgeId; });
+  ASSERT_EQ(result.size(), edges.size());
+  LCA lca(mst);
+  for (std::size_t i = 0; i < edges.size(); ++i) {
+    const auto& e = edges[i];
+    const auto& s = result[i];
+    ASSERT_EQ(s.edgeId, e.edgeId);
+    EXPECT_EQ(s.inTree, std::binary_search(treeIds.begin(), treeIds.end(), e.edgeId));
+    if (e.v1 == e.v2) {
+      EXPECT_EQ(s.threshold, WEIGHT_MIN);
+      EXPECT_EQ(s.replacement, -1);
+    }
+    else if (!s.inTree) {
+      EXPECT_EQ(s.threshold, lca.maxEdgeWeight(e.v1, e.v2));
+      EXPECT_EQ(G.edgeByID(s.replacement).weight, s.threshold);
+    }
+    else {
+      //cut the tree edge, the lightest non-tree edge across the cut replaces it
+      UnionFind uf(N);
+      for (int id : treeIds) {
+        if (id != e.edgeId) uf.merge(G.edgeByID(id).v1, G.edgeByID(id).v2);
+      }
+      Graph::Edge best {WEIGHT_MAX, -1, -1, -1};
+      for (const auto& f : edges) {
+        if (f.edgeId == e.edgeId || uf.sameSet(f.v1, f.v2)) continue;
+        if (best.edgeId == -1 || lighterEdge(f, best)) best = f;
+      }
+      EXPECT_EQ(s.threshold, best.weight);
+      EXPECT_EQ(s.replacement, best.edgeId);
+    }
+  }
+  EXPECT_EQ(sensitivityAnalysis(G).size(), result.size());
+}
+
+TEST(SensitivityTest, bridgesAndDisconnectedGraph) {
+  //triangle 0-1-2 with a pendant vertex 3, separate edge 4-5
+  Graph G {6};
+  G.addEdge({1, 0, 1});
+  G.addEdge({2, 1, 2});
+  G.addEdge({3, 0, 2});
+  G.addEdge({4, 2, 3});
+  G.addEdge({5, 4, 5});
+  std::vector<EdgeSensitivity> result = sensitivityAnalysis(G);
+  ASSERT_EQ(result.size(), 5u);
+  EXPECT_TRUE(result[0].inTree);
+  EXPECT_EQ(result[0].threshold, 3);
+  EXPECT_EQ(result[0].replacement, 2);
+  EXPECT_TRUE(result[1].inTree);
+  EXPECT_EQ(result[1].replacement, 2);
+  EXPECT_FALSE(result[2].inTree);
+  EXPECT_EQ(result[2].threshold, 2);
+  EXPECT_EQ(result[2].replacement, 1);
+  for (int id : {3, 4}) {
+    EXPECT_TRUE(result[id].inTree);
+    EXPECT_EQ(result[id].threshold, WEIGHT_MAX);
+    EXPECT_EQ(result[id].replacement, -1);
+  }
+}
+
+TEST(SensitivityTest, kBestAgainstEnumeration) {
+  const int N = 6;
+  std::mt19937 mt {1'717};
+  std::uniform_int_distribution<int> weightDist {1, 9};
+  Graph G {N};
+  for (int v = 1; v < N; ++v) G.addEdge({static_cast<Weight>(weightDist(mt)), v - 1, v});
+  for (auto [u, v] : {std::pair {0, 2}, {1, 4}, {2, 5}, {0, 5}, {3, 5}}) {
+    G.addEdge({static_cast<Weight>(weightDist(mt)), u, v});
+  }
+  G.addEdge({0, 4, 4});
+  //weights of all spanning trees, from every subset of N - 1 edges
+  std::vector<Graph::Edge> edges;
+  for (int id = 0; id < 10; ++id) edges.push_back(G.edgeByID(id));
+  std::vector<double> all;
+  for (int mask = 0; mask < (1 << 10); ++mask) {
+    if (__builtin_popcount(mask) != N - 1) continue;
+    UnionFind uf(N);
+    double weight = 0;
+    for (int i = 0; i < 10; ++i) {
+      if (mask & (1 << i)) {
+        uf.merge(edges[i].v1, edges[i].v2);
+        weight += edges[i].weight;
+      }
+    }
+    if (uf.numberOfComponents() == 1) all.push_back(weight);
+  }
+  std::sort(all.begin(), all.end());
+  std::vector<Graph> trees = kBestSpanningTrees(G, 1'000);
+  ASSERT_EQ(trees.size(), all.size());
+  std::set<std::vector<Index> > distinct;
+  for (std::size_t i = 0; i < trees.size(); ++i) {
+    EXPECT_EQ(trees[i].edgeWeightSum(), all[i]);
+    distinct.insert(forestEdgeIds(trees[i]));
+    EXPECT_EQ(forestEdgeIds(trees[i]).size(), static_cast<std::size_t>(N - 1));
+  }
+  EXPECT_EQ(distinct.size(), trees.size());
+  EXPECT_EQ(forestEdgeIds(trees[0]), forestEdgeIds(boruvkaMST(G)));
+  EXPECT_EQ(kBestSpanningTrees(G, 3).size(), 3u);
+  EXPECT_TRUE(kBestSpanningTrees(G, 0).empty());
+}
+
+//===========BOTTLENECK ORACLE TEST=================
+
+TEST(BottleneckTest, sameAsLCA) {
+  //two random components, an isolated vertex and a vertex with only a self-loop
+  const int N = 2'002;
+  Graph G {N};
+  Graph a = randomDistinctWeightGraph(1'000, 5'000, 4'141);
+  Graph b = randomDistinctWeightGraph(1'000, 5'000, 4'142);
+  for (int u = 0; u < 1'000; ++u) {
+    for (auto e : *a.neighbours(u)) {
+      if (u == e.v1) G.addEdge({e.weight, e.v1, e.v2});
+    }
+    for (auto e : *b.neighbours(u)) {
+      if (u == e.v1) G.addEdge({e.weight, e.v1 + 1'000, e.v2 + 1'000});
+    }
+  }
+  G.addEdge({5, 2'001, 2'001});
+  Graph mst = kktMST(G);
+  BottleneckOracle oracle(mst);
+  LCA lca(mst);
+  EXPECT_EQ(oracle.numVertices(), N);
+  std::mt19937 mt {5'151};
+  std::uniform_int_distribution<int> indexDist {0, N - 1};
+  for (int i = 0; i < 20'000; ++i) {
+    int u = indexDist(mt);
+    int v = (i % 10 == 0) ? u : indexDist(mt);
+    Weight expected = lca.maxEdgeWeight(u, v);
+    ASSERT_EQ(oracle.bottleneck(u, v), expected);
+    Index id = oracle.bottleneckEdge(u, v);
+    if (u == v || !oracle.connected(u, v)) {
+      EXPECT_EQ(id, -1);
+    }
+    else {
+      EXPECT_EQ(mst.edgeByID(id).weight, expected);
+    }
+  }
+  EXPECT_FALSE(oracle.connected(0, 1'000));
+  EXPECT_FALSE(oracle.connected(2'000, 2'001));
+  EXPECT_TRUE(oracle.connected(1'000, 1'999));
+  EXPECT_EQ(BottleneckOracle(Graph {0}).numVertices(), 0);
+}
+
+TEST(BottleneckTest, saveAndLoad) {
+  Graph G = randomDistinctWeightGraph(3'000, 12'000, 6'262);
+  G.addEdge({1, 3'000 - 1, 3'000 - 1});
+  BottleneckOracle oracle(boruvkaMST(G));
+  std::string file = (std::filesystem::temp_directory_path() / "bottleneck_oracle.bin").string();
+  ASSERT_TRUE(oracle.save(file));
+  BottleneckOracle loaded;
+  ASSERT_TRUE(loaded.load(file));
+  EXPECT_EQ(loaded.memoryBytes(), oracle.memoryBytes());
+  for (int u = 0; u < 3'000; u += 7) {
+    for (int v = 0; v < 3'000; v += 131) {
+      ASSERT_EQ(loaded.bottleneck(u, v), oracle.bottleneck(u, v));
+      ASSERT_EQ(loaded.bottleneckEdge(u, v), oracle.bottleneckEdge(u, v));
+    }
+  }
+  //truncated file is rejected and leaves the oracle as it was
+  std::filesystem::resize_file(file, std::filesystem::file_size(file) / 2);
+  EXPECT_FALSE(loaded.load(file));
+  EXPECT_EQ(loaded.numVertices(), 3'000);
+  std::filesystem::remove(file);
+  EXPECT_FALSE(loaded.load(file));
+}
+
+TEST(BottleneckTest, loadRejectsComponentsOutsideTheTrees) {
+  //two trees {0, 1} and {2, 3}; a file claiming they are one tree is rejected
+  BottleneckOracle oracle(testGraph(4, {{1, 0, 1}, {2, 2, 3}}));
+  std::string file = (std::filesystem::temp_directory_path() / "bottleneck_components.bin").string();
+  ASSERT_TRUE(oracle.save(file));
+  BottleneckOracle loaded;
+  ASSERT_TRUE(loaded.load(file));
+  EXPECT_FALSE(loaded.connected(0, 2));
+  {
+    //header, count, then the position vector and the component vector (count + 4 indices each)
+    std::fstream out {file, std::ios::binary | std::ios::in | std::ios::out};
+    out.seekp(4 + 4 + 2 + 8 + (8 + 4 * sizeof(Index)) + 8);
+    std::vector<Index> oneTree(4, 0);
+    out.write(reinterpret_cast<const char*>(oneTree.data()), static_cast<std::streamsize>(4 * sizeof(Index)));
+  }
+  EXPECT_FALSE(loaded.load(file));
+  EXPECT_FALSE(loaded.connected(0, 2));
+  std::filesystem::remove(file);
+}
+
+TEST(BottleneckTest, concurrentQueries) {
+  const int N = 20'000;
+  Graph G = randomDistinctWeightGraph(N, 80'000, 7'373);
+  const BottleneckOracle oracle(boruvkaMST(G));
+  std::vector<std::pair<int, int> > queries;
+  std::mt19937 mt {7'374};
+  std::uniform_int_distribution<int> indexDist {0, N - 1};
+  for (int i = 0; i < 40'000; ++i) queries.push_back({indexDist(mt), indexDist(mt)});
+  std::vector<Weight> expected;
+  for (auto [u, v] : queries) expected.push_back(oracle.bottleneck(u, v));
+  const int numThreads = 4;
+  std::vector<int> mismatches(numThreads, 0);
+  std::vector<std::thread> threads;
+  for (int t = 0; t < numThreads; ++t) {
+    threads.emplace_back([&, t] {
+      for (std::size_t i = t; i < queries.size(); i += numThreads) {
+        if (oracle.bottleneck(queries[i].first, queries[i].second) != expected[i]) ++mismatches[t];
+      }
+    });
+  }
+  for (auto& th : threads) th.join();
+  EXPECT_EQ(std::accumulate(mismatches.begin(), mismatches.end(), 0), 0);
+}
+
+//===========SPANNING FOREST RESULT TEST=================
+
+TEST(SpanningForestTest, sameAsGraphResult) {
+  Graph G = randomDistinctWeightGraph(5'000, 30'000, 9'191);
+  SpanningForest fromBoruvka = boruvkaSpanningForest(G);
+  SpanningForest fromKKT = kktSpanningForest(G);
+  Graph expected = boruvkaMST(G);
+  EXPECT_TRUE(fromBoruvka.toGraph() == expected);
+  for (const auto* F : {&fromBoruvka, &fromKKT}) {
+    EXPECT_EQ(F->numVertices, 5'000);
+    EXPECT_EQ(F->numComponents(), 1);
+    std::vector<Index> ids = F->edgeIds();
+    EXPECT_EQ(ids, forestEdgeIds(expected));
+    EXPECT_NEAR(F->weight, expected.edgeWeightSum(), 1e-9);
+    for (const auto& e : F->edges) EXPECT_EQ(e, G.edgeByID(e.edgeId));
+  }
+  EXPECT_TRUE(canonicalForm(fromKKT.toGraph()) == canonicalForm(expected));
+  EXPECT_LT(fromKKT.memoryBytes(), expected.memoryBytes());
+}
+
+TEST(SpanningForestTest, disconnectedGraph) {
+  //components {0,1,2}, {3,4}, {5}
+  Graph G {6, {{4, 0, 1}, {2, 1, 2}, {7, 0, 2}, {1, 3, 4}, {5, 5, 5}}};
+  for (const auto& F : {boruvkaSpanningForest(G), kktSpanningForest(G)}) {
+    EXPECT_EQ(F.numComponents(), 3);
+    EXPECT_EQ(F.weight, 7);
+    EXPECT_EQ(F.edgeIds(), (std::vector<Index> {0, 1, 3}));
+    UnionFind uf(6);
+    for (const auto& e : F.edges) uf.merge(e.v1, e.v2);
+    ForestComponents C = forestComponents(F, uf);
+    EXPECT_EQ(C.label, (std::vector<Index> {0, 0, 0, 1, 1, 2}));
+    EXPECT_EQ(C.weight, (std::vector<WeightSum> {6, 1, 0}));
+  }
+  EXPECT_EQ(boruvkaSpanningForest(Graph {0}).numComponents(), 0);
+  EXPECT_EQ(kktSpanningForest(Graph {1}).toGraph().numVertices(), 1);
+}
+
+//===========BATCH MST TEST=================
+
+TEST(BatchMSTTest, sameAsBoruvkaPerGraph) {
+  //sizes on both sides of the dense Prim limit, integer weights with ties,
+  //a few self-loops and out-of-range endpoints
+  std::mt19937 mt {24'680};
+  GraphBatch batch;
+  for (int g = 0; g < 300; ++g) {
+    int n = std::uniform_int_distribution<int> {0, 120}(mt);
+    int m = std::uniform_int_distribution<int> {0, 4 * n}(mt);
+    std::uniform_int_distribution<int> indexDist {0, n};
+    std::vector<Graph::Edge> edges;
+    for (int i = 0; i < m; ++i) {
+      edges.push_back({static_cast<Weight>(std::uniform_int_distribution<int> {0, 9}(mt)), indexDist(mt), indexDist(mt)});
+    }
+    batch.add(n, edges);
+  }
+  BatchForests forests = batchMST(batch, 1);
+  ASSERT_EQ(forests.numGraphs(), batch.numGraphs());
+  for (std::size_t g = 0; g < batch.numGraphs(); ++g) {
+    //edge IDs are the positions, as in the batch's tie-breaking
+    std::vector<Graph::Edge> slice(batch.edges.begin() + batch.edgeOffset[g],
+                                   batch.edges.begin() + batch.edgeOffset[g + 1]);
+    for (int i = 0; i < static_cast<int>(slice.size()); ++i) slice[i].edgeId = i;
+    Graph expected = boruvkaMST(Graph(batch.numVertices[g], slice));
+    std::vector<Index> chosen(forests.edges.begin() + forests.offset[g],
+                            forests.edges.begin() + forests.offset[g + 1]);
+    std::sort(chosen.begin(), chosen.end());
+    ASSERT_EQ(chosen, forestEdgeIds(expected)) << "graph " << g << ", n = " << batch.numVertices[g];
+    EXPECT_EQ(forests.weight[g], expected.edgeWeightSum());
+  }
+  BatchForests threaded = batchMST(batch, 4);
+  EXPECT_EQ(threaded.offset, forests.offset);
+  EXPECT_EQ(threaded.edges, forests.edges);
+  EXPECT_EQ(threaded.weight, forests.weight);
+}
+
+TEST(BatchMSTTest, smallCases) {
+  EXPECT_EQ(batchMST(GraphBatch {}).numGraphs(), 0u);
+  GraphBatch batch;
+  batch.add(0, {});
+  batch.add(1, {{2, 0, 0}});
+  batch.add(Graph {5, {{4, 0, 1}, {2, 1, 2}, {7, 0, 2}, {1, 3, 4}, {3, 4, 4}}});
+  Graph big = randomDistinctWeightGraph(500, 2'000, 1'357);
+  batch.add(big);
+  BatchForests forests = batchMST(batch);
+  EXPECT_EQ(forests.offset, (std::vector<std::size_t> {0, 0, 0, 3, 502}));
+  EXPECT_EQ(forests.weight[2], 7);
+  EXPECT_NEAR(forests.weight[3], boruvkaMST(big).edgeWeightSum(), 1e-9);
+  //positions in adjacency order: 0-1, 0-2, 1-2, 3-4 (the self-loop is left out)
+  std::vector<Index> small(forests.edges.begin(), forests.edges.begin() + 3);
+  std::sort(small.begin(), small.end());
+  EXPECT_EQ(small, (std::vector<Index> {0, 2, 3}));
+}
+
+//===========RADIX SORT KRUSKAL TEST=================
+
+TEST(RadixKruskalTest, weightKeyPreservesOrder) {
+  using Limits = std::numeric_limits<Weight>;
+  std::vector<Weight> weights {WEIGHT_MIN, Limits::lowest(), -3, -1, 0, 1, 3, Limits::max(), WEIGHT_MAX};
+  if constexpr (std::is_floating_point_v<Weight>) {
+    for (Weight w : {Weight(-2.5), -Limits::denorm_min(), Weight(-0.0), Limits::denorm_min(), Weight(0.5)}) {
+      weights.push_back(w);
+    }
+  }
+  for (std::size_t i = 0; i < weights.size(); ++i) {
+    for (std::size_t j = 0; j < weights.size(); ++j) {
+      EXPECT_EQ(weights[i] < weights[j], weightKey(weights[i]) < weightKey(weights[j])) << i << " " << j;
+    }
+  }
+  EXPECT_EQ(weightKey(static_cast<Weight>(-0.0)), weightKey(0));
+}
+
+TEST(RadixKruskalTest, sameForestAsOtherEngines) {
+  //real weights, and small integer weights with many ties (most passes are skipped)
+  Graph real = randomDistinctWeightGraph(20'000, 300'000, 7'777);
+  std::mt19937 mt {7'778};
+  std::uniform_int_distribution<int> indexDist {0, 19'999};
+  std::uniform_int_distribution<int> weightDist {-50, 50};
+  Graph ties {20'000};
+  for (int i = 0; i < 300'000; ++i) ties.addEdge({static_cast<Weight>(weightDist(mt)), indexDist(mt), indexDist(mt)});
+  ties.addEdge({-100, 5, 5});
+  for (const Graph* G : {&real, &ties}) {
+    std::vector<Index> expected = forestEdgeIds(kruskalTotalOrder(*G));
+    EXPECT_EQ(forestEdgeIds(radixKruskalMST(*G)), expected);
+    SpanningForest threaded = radixKruskalForest(*G, 4);
+    std::vector<Index> ids = threaded.edgeIds();
+    EXPECT_EQ(ids, expected);
+    EXPECT_NEAR(threaded.weight, boruvkaMST(*G).edgeWeightSum(), 1e-6);
+  }
+}
+
+TEST(RadixKruskalTest, smallAndDisconnected) {
+  EXPECT_EQ(radixKruskalMST(Graph {0}).numVertices(), 0);
+  Graph G {6, {{4, 0, 1}, {2, 1, 2}, {7, 0, 2}, {1, 3, 4}, {5, 5, 5}, {2, 2, 1}}};
+  SpanningForest F = radixKruskalForest(G, 0);
+  EXPECT_EQ(F.edgeIds(), (std::vector<Index> {0, 1, 3}));
+  EXPECT_EQ(F.numComponents(), 3);
+  EXPECT_EQ(F.weight, 7);
+}
+
+//===========NUMA-AWARE BORUVKA TEST=================
+
+TEST(NumaTest, cpuListAndTopology) {
+  EXPECT_EQ(parseCpuList("0-3,8,10-11\n"), (std::vector<int> {0, 1, 2, 3, 8, 10, 11}));
+  EXPECT_EQ(parseCpuList("5"), (std::vector<int> {5}));
+  EXPECT_TRUE(parseCpuList("").empty());
+  EXPECT_TRUE(parseCpuList("3-1").empty());
+  EXPECT_TRUE(parseCpuList("0-x").empty());
+  NumaTopology topology = numaTopology();
+  ASSERT_GE(topology.numNodes(), 1);
+  for (const auto& cpus : topology.cpus) EXPECT_FALSE(cpus.empty());
+}
+
+TEST(NumaTest, sameForestForEveryLayout) {
+  Graph G = randomDistinctWeightGraph(30'000, 200'000, 4'444);
+  G.addEdge({2, 17, 17});
+  std::vector<Index> expected = forestEdgeIds(kruskalTotalOrder(G));
+  for (auto placement : {NumaPlacement::Local, NumaPlacement::Interleaved}) {
+    for (int numThreads : {1, 3, 8}) {
+      SpanningForest F = numaBoruvkaForest(G, {numThreads, placement, numThreads != 8});
+      std::vector<Index> ids = F.edgeIds();
+      EXPECT_EQ(ids, expected) << numThreads << " threads";
+    }
+  }
+}
+
+TEST(NumaTest, disconnectedAndTiny) {
+  EXPECT_EQ(numaBoruvkaForest(Graph {0}).numComponents(), 0);
+  EXPECT_EQ(numaBoruvkaForest(Graph {1}).numComponents(), 1);
+  Graph G {6, {{4, 0, 1}, {2, 1, 2}, {7, 0, 2}, {1, 3, 4}, {5, 5, 5}, {2, 2, 1}}};
+  SpanningForest F = numaBoruvkaForest(G);
+  EXPECT_EQ(F.edgeIds(), (std::vector<Index> {0, 1, 3}));
+  EXPECT_EQ(F.weight, 7);
+  //equal weights everywhere: ties go by edge ID
+  Graph ties {1'000};
+  for (int v = 0; v < 1'000; ++v) {
+    ties.addEdge({1, v, (v + 1) % 1'000});
+    ties.addEdge({1, v, (v * 7 + 3) % 1'000});
+  }
+  std::vector<Index> ids = numaBoruvkaForest(ties, {4}).edgeIds();
+  EXPECT_EQ(ids, forestEdgeIds(kruskalTotalOrder(ties)));
+}
+
+//===========APPROXIMATE MST TEST=================
+
+TEST(ApproximateMSTTest, withinBoundOfBoruvka) {
+  Graph G = randomEuclideanGraph(20'000, 200'000, 5'656);
+  WeightSum optimum = boruvkaMST(G).edgeWeightSum();
+  for (double epsilon : {0.5, 0.1, 0.01}) {
+    ApproximateForest A = approximateMST(G, epsilon);
+    EXPECT_EQ(A.forest.numComponents(), forestComponents(boruvkaMST(G)).numComponents());
+    EXPECT_GE(A.forest.weight, optimum - 1e-6);
+    EXPECT_LE(A.forest.weight, (1 + epsilon) * optimum + 1e-6) << "epsilon " << epsilon;
+    //the certificate brackets the optimum
+    EXPECT_LE(A.lowerBound, optimum + 1e-6);
+    EXPECT_LE(A.errorBound, epsilon + 1e-12);
+    EXPECT_LE(A.forest.weight, (1 + A.errorBound) * optimum + 1e-6);
+    EXPECT_GT(A.numClasses, 1u);
+    //still a forest of G
+    UnionFind uf(G.numVertices());
+    for (const auto& e : A.forest.edges) {
+      EXPECT_FALSE(uf.sameSet(e.v1, e.v2));
+      uf.merge(e.v1, e.v2);
+      EXPECT_EQ(e, G.edgeByID(e.edgeId));
+    }
+  }
+}
+
+TEST(ApproximateMSTTest, exactCasesAndSpecialWeights) {
+  Graph G = randomDistinctWeightGraph(2'000, 10'000, 5'757);
+  ApproximateForest exact = approximateMST(G, 0);
+  std::vector<Index> ids = exact.forest.edgeIds();
+  EXPECT_EQ(ids, forestEdgeIds(boruvkaMST(G)));
+  EXPECT_EQ(exact.errorBound, 0);
+  //zero and negative weights are taken exactly, before the positive classes
+  Graph H {5, {{-3, 0, 1}, {0, 1, 2}, {-1, 0, 2}, {4, 2, 3}, {5, 3, 4}, {9, 1, 4}, {2, 4, 4}}};
+  ApproximateForest A = approximateMST(H, 0.2);
+  EXPECT_EQ(A.forest.edgeIds(), (std::vector<Index> {0, 2, 3, 4}));
+  EXPECT_EQ(approximateMST(Graph {0}, 0.1).forest.numComponents(), 0);
+  //all weights in one class: any spanning tree is within the bound
+  Graph equal = testGraph(4, {{1, 0, 1}, {1.05, 1, 2}, {1.01, 2, 3}, {1.02, 3, 0}});
+  ApproximateForest B = approximateMST(equal, 0.1);
+  EXPECT_EQ(B.numClasses, 2u);
+  EXPECT_LE(B.forest.weight, 1.1 * boruvkaMST(equal).edgeWeightSum());
+  EXPECT_DOUBLE_EQ(B.lowerBound, 3 * WEIGHT_SCALE);
+}
+
+TEST(CompressedGraphTest, sameEdgesAndNeighbours) {
+  //random graph with parallel edges and self-loops, plus an isolated tail of vertices
+  Graph G = randomEuclideanGraph(3'000, 12'000, 6'161);
+  G.addEdge({3, 17, 17});
+  G.addEdge({2, 40, 41});
+  G.addEdge({2, 41, 40});
+  CompressedGraph C(G);
+  std::vector<Graph::Edge> expected;
+  for (Index u = 0; u < G.numVertices(); ++u) {
+    for (const auto& e : *G.neighbours(u)) {
+      if (u == e.v1 && e.v1 != e.v2) expected.push_back({e.weight, std::min(e.v1, e.v2), std::max(e.v1, e.v2), e.edgeId});
+    }
+  }
+  ASSERT_EQ(C.numEdges(), static_cast<Index>(expected.size()));
+  EXPECT_EQ(canonicalForm(C.toGraph()), canonicalForm(Graph(G.numVertices(), expected)));
+  //every edge index shows up at both ends, neighbours in increasing order
+  std::vector<std::pair<Index, Index> > ends(C.numEdges(), {-1, -1});
+  C.forEachEdge([&](Index u, Index v, Index e) { ends[e] = {u, v}; });
+  std::vector<int> seen(C.numEdges(), 0);
+  for (Index u = 0; u < C.numVertices(); ++u) {
+    Index previous = -1;
+    C.forEachNeighbour(u, [&](Index v, Index e) {
+      EXPECT_LE(previous, v);
+      previous = v;
+      EXPECT_EQ(ends[e], std::pair(std::min(u, v), std::max(u, v)));
+      ++seen[e];
+    });
+  }
+  EXPECT_TRUE(std::all_of(seen.begin(), seen.end(), [](int count) { return count == 2; }));
+  EXPECT_EQ(CompressedGraph(Graph {0}).numEdges(), 0);
+}
+
+TEST(CompressedGraphTest, enginesAndEncodings) {
+  Graph G = randomDistinctWeightGraph(4'000, 20'000, 6'262);
+  G.addEdge({1, 4'000, 4'001});                    //no vertex 4000: dropped, G stays connected
+  std::vector<Index> expected = forestEdgeIds(boruvkaMST(G));
+  WeightSum optimum = boruvkaMST(G).edgeWeightSum();
+  CompressedGraph exact(G);
+  for (const SpanningForest& F : {compressedBoruvkaForest(exact), compressedPrimForest(exact)}) {
+    std::vector<Index> ids = F.edgeIds();
+    EXPECT_EQ(ids, expected);
+    EXPECT_NEAR(F.weight, optimum, 1e-6);
+  }
+  //rounded weights: both engines agree, the tree is near optimal in the true weights
+  for (WeightEncoding encoding : {WeightEncoding::Float32, WeightEncoding::Quantized16}) {
+    CompressedGraph C(G, encoding);
+    SpanningForest B = compressedBoruvkaForest(C);
+    SpanningForest P = compressedPrimForest(C);
+    EXPECT_EQ(B.edgeIds(), P.edgeIds());
+    EXPECT_EQ(B.numComponents(), 1);
+    WeightSum trueWeight = 0;
+    for (const auto& e : B.edges) trueWeight += G.edgeByID(e.edgeId).weight;
+    EXPECT_LE(trueWeight, optimum * 1.001);
+    //Float32 only saves space on 8-byte weights
+    if (encoding == WeightEncoding::Quantized16 || sizeof(Weight) > sizeof(float)) {
+      EXPECT_LT(C.bytesPerEdge(), exact.bytesPerEdge());
+    }
+  }
+  //forest of a disconnected graph, edges kept with their IDs
+  Graph H {6, {{3, 0, 1}, {1, 1, 2}, {2, 0, 2}, {5, 4, 5}, {7, 5, 4}}};
+  CompressedGraph D(H, WeightEncoding::Quantized16);
+  EXPECT_EQ(compressedPrimForest(D).edgeIds(), (std::vector<Index> {1, 2, 3}));
+  EXPECT_EQ(compressedBoruvkaForest(D).numComponents(), 3);
+}
+
+TEST(CompressedGraphTest, tiesBrokenByOriginalId) {
+  //three weights only, edges added in random order so IDs don't follow the edge indices
+  Graph G {2'000};
+  std::mt19937 mt {6'464};
+  std::uniform_int_distribution<Index> vertexDist {0, 1'999};
+  std::uniform_int_distribution<int> weightDist {1, 3};
+  for (int i = 0; i < 1'999; ++i) G.addEdge({testWeight(weightDist(mt)), i, i + 1});
+  for (int i = 0; i < 8'000; ++i) G.addEdge({testWeight(weightDist(mt)), vertexDist(mt), vertexDist(mt)});
+  std::vector<Index> expected = forestEdgeIds(boruvkaMST(G));
+  CompressedGraph C(G);
+  EXPECT_EQ(compressedBoruvkaForest(C).edgeIds(), expected);
+  EXPECT_EQ(compressedPrimForest(C).edgeIds(), expected);
+  for (Index e = 0; e < C.numEdges(); e += 97) EXPECT_EQ(C.originalId(e), C.originalIds({e})[0]);
+}
+
+TEST(CompressedGraphTest, gridUnderTenBytesPerEdge) {
+  //road-like graph: a grid in row-major order
+  const int side = 300;
+  Graph G {side * side};
+  std::mt19937 mt {6'363};
+  std::uniform_real_distribution<double> weightDist {1.0, 100.0};
+  for (int x = 0; x < side; ++x) {
+    for (int y = 0; y < side; ++y) {
+      if (x > 0) G.addEdge({testWeight(weightDist(mt)), (x - 1) * side + y, x * side + y});
+      if (y > 0) G.addEdge({testWeight(weightDist(mt)), x * side + y - 1, x * side + y});
+    }
+  }
+  CompressedGraph C(G, WeightEncoding::Quantized16);
+  EXPECT_LT(C.bytesPerEdge(), 10);
+  EXPECT_LT(CompressedGraph(G, WeightEncoding::Float32).bytesPerEdge(), 12);
+  EXPECT_EQ(compressedBoruvkaForest(C).edgeIds(), compressedPrimForest(C).edgeIds());
+}
+
+TEST(CompressedGraphTest, exactNarrowsWeightsWithoutLoss) {
+  //road-like grid with integer weights (e.g. travel times): Exact keeps them in 2 bytes
+  const int side = 300;
+  Graph G {side * side};
+  std::mt19937 mt {6'565};
+  std::uniform_int_distribution<int> weightDist {1, 1'000};
+  for (int x = 0; x < side; ++x) {
+    for (int y = 0; y < side; ++y) {
+      if (x > 0) G.addEdge({static_cast<Weight>(weightDist(mt)), (x - 1) * side + y, x * side + y});
+      if (y > 0) G.addEdge({static_cast<Weight>(weightDist(mt)), x * side + y - 1, x * side + y});
+    }
+  }
+  CompressedGraph C(G);
+  EXPECT_LT(C.bytesPerEdge(), 10);
+  EXPECT_EQ(canonicalForm(C.toGraph()), canonicalForm(G));
+  std::vector<Index> expected = forestEdgeIds(boruvkaMST(G));
+  EXPECT_EQ(compressedBoruvkaForest(C).edgeIds(), expected);
+  EXPECT_EQ(compressedPrimForest(C).edgeIds(), expected);
+  //weights that don't fit stay as they are
+  Graph H {4, {{1, 0, 1}, {100'000, 1, 2}, {-3, 2, 3}, {std::numeric_limits<Weight>::max(), 0, 3}}};
+  if constexpr (!std::is_integral_v<Weight>) H.addEdge({static_cast<Weight>(0.1), 0, 2});
+  EXPECT_EQ(canonicalForm(CompressedGraph(H).toGraph()), canonicalForm(H));
+  //fractions a float holds exactly
+  if constexpr (!std::is_integral_v<Weight>) {
+    Graph halves {3};
+    halves.addEdge({static_cast<Weight>(0.5), 0, 1});
+    halves.addEdge({static_cast<Weight>(1e6 + 0.25), 1, 2});
+    halves.addEdge({static_cast<Weight>(-2.75), 0, 2});
+    CompressedGraph D(halves);
+    EXPECT_EQ(canonicalForm(D.toGraph()), canonicalForm(halves));
+    EXPECT_EQ(compressedPrimForest(D).edgeIds(), (std::vector<Index> {0, 2}));
+  }
+}
+
+TEST(PartitionedMSTTest, sameAsSingleProcess) {
+  for (auto [N, m, seed] : {std::tuple {2'000, 10'000, 7'171u}, std::tuple {20'000, 150'000, 7'272u},
+                            std::tuple {5'000, 4'000, 7'373u}}) {
+    Graph G = randomEuclideanGraph(N, m, seed);
+    Graph single = boruvkaMST(G);
+    for (auto [parts, fanIn] : {std::pair {1, 2}, std::pair {3, 2}, std::pair {8, 2}, std::pair {7, 4}}) {
+      SpanningForest F = partitionedMSTForest(G, {parts, fanIn});
+      std::vector<Index> ids = F.edgeIds();
+      EXPECT_EQ(ids, forestEdgeIds(single)) << parts << " partitions";
+      EXPECT_NEAR(F.weight, single.edgeWeightSum(), 1e-6);
+    }
+  }
+}
+
+TEST(PartitionedMSTTest, tiesAndSmallGraphs) {
+  //unit weights: the ID tie-break picks one tree, partitions must not change it
+  Graph G = randomEuclideanGraph(1'000, 6'000, 7'474);
+  std::vector<Graph::Edge> unit;
+  for (Index u = 0; u < G.numVertices(); ++u) {
+    for (const auto& e : *G.neighbours(u)) {
+      if (u == e.v1) unit.push_back({1, e.v1, e.v2, e.edgeId});
+    }
+  }
+  Graph U(G.numVertices(), unit);
+  EXPECT_EQ(canonicalForm(partitionedMST(U, {5, 2})), canonicalForm(boruvkaMST(U)));
+  EXPECT_EQ(partitionedMSTForest(Graph {0}).numComponents(), 0);
+  EXPECT_EQ(partitionedMSTForest(Graph {4}, {3, 2}).numComponents(), 4);
+  Graph H {5, {{2, 0, 1}, {1, 1, 2}, {3, 3, 4}, {1, 3, 3}}};
+  EXPECT_EQ(partitionedMSTForest(H, {16, 2}).edgeIds(), (std::vector<Index> {0, 1, 2}));
+}
+
+TEST(ThreadPoolTest, parallelForCoversEveryIndexOnce) {
+  for (int threads : {1, 4}) {
+    ThreadPool pool(threads);
+    EXPECT_EQ(pool.numThreads(), threads);
+    const int n = 100'003;
+    std::vector<std::atomic<int> > hits(n);
+    std::atomic<int> tooLarge {0};
+    pool.parallelFor(0, n, 64, [&](int lo, int hi) {
+      if (hi - lo > 64) ++tooLarge;
+      for (int i = lo; i < hi; ++i) ++hits[i];
+    });
+    EXPECT_EQ(tooLarge, 0);
+    EXPECT_TRUE(std::all_of(hits.begin(), hits.end(), [](const std::atomic<int>& h) { return h == 1; }));
+    //automatic grain, empty range
+    std::atomic<long long> sum {0};
+    pool.parallelFor<std::size_t>(0, 1'000, 0, [&](std::size_t lo, std::size_t hi) {
+      for (std::size_t i = lo; i < hi; ++i) sum += static_cast<long long>(i);
+    });
+    EXPECT_EQ(sum, 999 * 1'000 / 2);
+    pool.parallelFor(5, 5, 1, [&](int, int) { ADD_FAILURE(); });
+  }
+}
+
+TEST(ThreadPoolTest, reduceIsDeterministicAndExceptionsPropagate) {
+  std::vector<double> values(200'000);
+  std::mt19937 mt {8'181};
+  std::uniform_real_distribution<double> dist {-1e6, 1e6};
+  for (auto& v : values) v = dist(mt);
+  auto sumOf = [&values](ThreadPool& pool) {
+    return pool.parallelReduce(std::size_t {0}, values.size(), std::size_t {1'000}, 0.0,
+        [&values](std::size_t lo, std::size_t hi) {
+          double s = 0;
+          for (std::size_t i = lo; i < hi; ++i) s += values[i];
+          return s;
+        },
+        [](double a, double b) { return a + b; });
+  };
+  ThreadPool one(1);
+  ThreadPool four(4);
+  double expected = sumOf(one);
+  for (int repeat = 0; repeat < 5; ++repeat) EXPECT_EQ(sumOf(four), expected);   //bit-identical
+  EXPECT_EQ(four.parallelReduce(3, 3, 1, 7, [](int, int) { return 0; }, std::plus<int>()), 7);
+  EXPECT_THROW(four.parallelFor(0, 1'000, 10, [](int lo, int) {
+    if (lo == 500) throw std::runtime_error("task failed");
+  }), std::runtime_error);
+  //still usable afterwards
+  std::atomic<int> count {0};
+  four.parallelFor(0, 1'000, 10, [&](int lo, int hi) { count += hi - lo; });
+  EXPECT_EQ(count, 1'000);
+}
+
+long long poolFib(ThreadPool& pool, int k) {
+  if (k < 15) return k < 2 ? k : poolFib(pool, k - 1) + poolFib(pool, k - 2);
+  long long a = 0;
+  TaskGroup group(pool);
+  group.run([&] { a = poolFib(pool, k - 1); });
+  long long b = poolFib(pool, k - 2);
+  group.wait();
+  return a + b;
+}
+
+TEST(ThreadPoolTest, forkJoinAndPerThreadScratch) {
+  ThreadPool pool(3);
+  EXPECT_EQ(poolFib(pool, 27), 196'418);
+  EXPECT_EQ(pool.threadIndex(), 0);
+  PerThread<long long> partial(pool);
+  std::atomic<bool> badIndex {false};
+  pool.parallelFor(0, 50'000, 100, [&](int lo, int hi) {
+    if (pool.threadIndex() < 0 || pool.threadIndex() >= pool.numThreads()) badIndex = true;
+    for (int i = lo; i < hi; ++i) partial.local() += i;
+  });
+  long long total = 0;
+  partial.forEach([&](long long value) { total += value; });
+  EXPECT_FALSE(badIndex);
+  EXPECT_EQ(total, 49'999LL * 50'000 / 2);
+  //the global pool is sized once
+  EXPECT_GE(globalThreadPool().numThreads(), 1);
+  EXPECT_FALSE(setGlobalThreadPoolSize(2));
+}
+
+TEST(BoruvkaHierarchyTest, levelsAreConsistentWithG) {
+  Graph G = randomDistinctWeightGraph(3'000, 9'000, 9'191);
+  G.addEdge({5, 7, 7});                            //self-loop, never part of a level
+  BoruvkaHierarchy H = boruvkaHierarchy(G);
+  std::vector<Index> ids = H.forest.edgeIds();
+  EXPECT_EQ(ids, forestEdgeIds(boruvkaMST(G)));
+  int rounds = H.numRounds();
+  ASSERT_GT(rounds, 1);
+  ASSERT_EQ(static_cast<int>(H.numVertices.size()), rounds + 1);
+  EXPECT_EQ(H.numVertices.back(), H.forest.numComponents());
+  EXPECT_EQ(H.edgeOffset[rounds] - H.edgeOffset[rounds - 1], 0u);     //last level has no edges
+  for (int r = 0; r < rounds; ++r) {
+    EXPECT_LT(H.numVertices[r + 1], H.numVertices[r]);
+    std::vector<Index> below = H.projection(r);
+    std::vector<Index> above = H.projection(r + 1);
+    //chosen edges join two vertices of level r into one of level r + 1
+    for (std::size_t k = H.chosenOffset[r]; k < H.chosenOffset[r + 1]; ++k) {
+      const auto& e = H.forest.edges[k];
+      EXPECT_NE(below[e.v1], below[e.v2]);
+      EXPECT_EQ(above[e.v1], above[e.v2]);
+    }
+    //level r + 1 keeps exactly the lightest edge of G between every pair of its vertices
+    std::map<std::pair<Index, Index>, Graph::Edge> lightest;
+    for (Index u = 0; u < G.numVertices(); ++u) {
+      for (const auto& e : *G.neighbours(u)) {
+        Index a = above[e.v1];
+        Index b = above[e.v2];
+        if (u != e.v1 || a == b) continue;
+        auto key = std::pair {std::min(a, b), std::max(a, b)};
+        auto it = lightest.find(key);
+        if (it == lightest.end() || lighterEdge(e, it->second)) lightest[key] = e;
+      }
+    }
+    ASSERT_EQ(H.edgeOffset[r + 1] - H.edgeOffset[r], lightest.size());
+    for (std::size_t k = H.edgeOffset[r]; k < H.edgeOffset[r + 1]; ++k) {
+      const auto& e = H.edges[k];
+      ASSERT_LT(e.v1, e.v2);
+      ASSERT_LT(e.v2, H.numVertices[r + 1]);
+      EXPECT_EQ(lightest.at({e.v1, e.v2}).edgeId, e.edgeId);
+      EXPECT_EQ(G.edgeByID(e.edgeId).weight, e.weight);
+    }
+  }
+}
+
+TEST(BoruvkaHierarchyTest, smallAndDisconnected) {
+  BoruvkaHierarchy empty = boruvkaHierarchy(Graph {0});
+  EXPECT_EQ(empty.numRounds(), 0);
+  EXPECT_EQ(empty.numVertices, (std::vector<Index> {0}));
+  BoruvkaHierarchy isolated = boruvkaHierarchy(Graph {3});
+  EXPECT_EQ(isolated.numRounds(), 0);
+  EXPECT_EQ(isolated.projection(0), (std::vector<Index> {0, 1, 2}));
+  //two paths and an isolated vertex, with a parallel edge
+  Graph G {7, {{1, 0, 1}, {2, 1, 2}, {3, 2, 3}, {5, 4, 5}, {4, 5, 4}}};
+  BoruvkaHierarchy H = boruvkaHierarchy(G);
+  EXPECT_EQ(H.forest.edgeIds(), (std::vector<Index> {0, 1, 2, 4}));
+  EXPECT_EQ(H.numVertices.front(), 7);
+  EXPECT_EQ(H.numVertices.back(), 3);
+  std::vector<Index> top = H.projection(H.numRounds());
+  EXPECT_EQ(top, (std::vector<Index> {0, 0, 0, 0, 1, 1, 2}));
+}
+
 int main(int argc, char* argv[]) {
   ::testing::InitGoogleTest(&argc, argv);
   return RUN_ALL_TESTS();
@@ -0,0 +1,103 @@
+#include "memory_tracker.hpp"
+#include "boruvka.hpp"
+#include "kkt.hpp"
+#include "graph.hpp"
+#include <algorithm>
+#include <string>
+
+MemoryBudgetError::MemoryBudgetError(std::size_t requested, std::size_t budget)
+    : std::runtime_error("memory budget exceeded: " + std::to_string(requested) +
+                         " bytes needed, budget " + std::to_string(budget) + " bytes"),
+      requestedBytes(requested), budgetBytes(budget) {}
+
+std::size_t MemoryBudgetError::requested() const {
+    return requestedBytes;
+}
+
+std::size_t MemoryBudgetError::budget() const {
+    return budgetBytes;
+}
+
+MemoryTracker::MemoryTracker(std::size_t budget) : limit(budget) {}
+
+void MemoryTracker::allocate(std::size_t bytes) {
+    if (!fits(bytes)) throw MemoryBudgetError(inUse + bytes, limit);
+    inUse += bytes;
+    updatePeaks();
+}
+
+void MemoryTracker::release(std::size_t bytes) {
+    inUse -= std::min(bytes, inUse);
+}
+
+std::size_t MemoryTracker::current() const {
+    return inUse;
+}
+
+std::size_t MemoryTracker::peak() const {
+    return maxInUse;
+}
+
+std::size_t MemoryTracker::budget() const {
+    return limit;
+}
+
+bool MemoryTracker::fits(std::size_t bytes) const {
+    return limit == 0 || inUse + bytes <= limit;
+}
+
+const std::vector<std::pair<std::string, std::size_t>>& MemoryTracker::phasePeaks() const {
+    return phases;
+}
+
+void MemoryTracker::updatePeaks() {
+    maxInUse = std::max(maxInUse, inUse);
+    if (activePhase != 0) {
+        auto& phasePeak = phases[activePhase - 1].second;
+        phasePeak = std::max(phasePeak, inUse);
+    }
+}
+
+MemoryCharge::MemoryCharge(MemoryTracker* tracker, std::size_t bytes) : tracker(tracker), bytes(bytes) {
+    if (tracker) tracker->allocate(bytes);
+}
+
+MemoryCharge::~MemoryCharge() {
+    release();
+}
+
+void MemoryCharge::release() {
+    if (tracker) tracker->release(bytes);
+    tracker = nullptr;
+}
+
+MemoryPhase::MemoryPhase(MemoryTracker* tracker, const std::string& name) : tracker(tracker) {
+    if (!tracker) return;
+    previous = tracker->activePhase;
+    auto& phases = tracker->phases;
+    auto it = std::find_if(phases.begin(), phases.end(),
+                           [&name](const auto& phase) { return phase.first == name; });
+    if (it == phases.end()) {
+        phases.push_back({name, 0});
+        it = phases.end() - 1;
+    }
+    tracker->activePhase = static_cast<std::size_t>(it - phases.begin()) + 1;
+    tracker->updatePeaks();
+}
+
+MemoryPhase::~MemoryPhase() {
+    if (tracker) tracker->activePhase = previous;
+}
+
+Graph budgetedMST(const Graph& G, MemoryTracker& tracker, OnBudgetExceeded policy) {
+    std::size_t leanest = boruvkaMemoryEstimate(G);
+    if (!tracker.fits(leanest)) throw MemoryBudgetError(tracker.current() + leanest, tracker.budget());
+    try {
+        return kktMST(G, &tracker);
+    }
+    catch (const MemoryBudgetError&) {
+        //every charge of the abandoned run has been released while unwinding
+        if (policy == OnBudgetExceeded::Fail) throw;
+    }
+    return boruvkaMST(G, &tracker);
+}
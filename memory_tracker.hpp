@@ -0,0 +1,97 @@
+#ifndef MEMORY_TRACKER_HPP_
+#define MEMORY_TRACKER_HPP_
+
+#include "graph.hpp"
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+//thrown when a tracked allocation would take a run past its memory budget
+class MemoryBudgetError : public std::runtime_error {
+    public:
+    MemoryBudgetError(std::size_t requested, std::size_t budget);
+    std::size_t requested() const;      //bytes that would have been in use
+    std::size_t budget() const;
+
+    private:
+    std::size_t requestedBytes;
+    std::size_t budgetBytes;
+};
+
+//Run-level memory accounting: engines report the footprint of their big structures
+//(Graph, UnionFind, LCA, ... via memoryBytes) while those are alive.
+//Keeps the current and peak total, the peak per phase, and enforces an optional budget.
+//Not thread-safe: one tracker per run.
+class MemoryTracker {
+    public:
+    //budget in bytes, 0: no limit
+    explicit MemoryTracker(std::size_t budget = 0);
+
+    //record bytes coming into use, throws MemoryBudgetError (recording nothing) past the budget
+    void allocate(std::size_t bytes);
+    //record bytes going out of use
+    void release(std::size_t bytes);
+
+    std::size_t current() const;
+    std::size_t peak() const;
+    std::size_t budget() const;
+    //would bytes more still fit the budget?
+    bool fits(std::size_t bytes) const;
+
+    //peak total seen while each phase was the innermost active one, in order of first use
+    const std::vector<std::pair<std::string, std::size_t>>& phasePeaks() const;
+
+    private:
+    friend class MemoryPhase;
+    std::size_t limit;
+    std::size_t inUse {0};
+    std::size_t maxInUse {0};
+    std::vector<std::pair<std::string, std::size_t>> phases;
+    std::size_t activePhase {0};        //position in phases + 1, 0: none
+
+    void updatePeaks();
+};
+
+//bytes charged to a tracker for the lifetime of this object (no-op with a null tracker)
+class MemoryCharge {
+    public:
+    MemoryCharge(MemoryTracker* tracker, std::size_t bytes);
+    ~MemoryCharge();
+    MemoryCharge(const MemoryCharge&) = delete;
+    MemoryCharge& operator=(const MemoryCharge&) = delete;
+
+    //release the bytes early
+    void release();
+
+    private:
+    MemoryTracker* tracker;
+    std::size_t bytes;
+};
+
+//makes name the active phase of a tracker until destroyed, then restores the previous one
+class MemoryPhase {
+    public:
+    MemoryPhase(MemoryTracker* tracker, const std::string& name);
+    ~MemoryPhase();
+    MemoryPhase(const MemoryPhase&) = delete;
+    MemoryPhase& operator=(const MemoryPhase&) = delete;
+
+    private:
+    MemoryTracker* tracker;
+    std::size_t previous {0};
+};
+
+//what budgetedMST does when kktMST would go past the budget
+enum class OnBudgetExceeded {
+    Fallback,       //abandon KKT and run boruvkaMST, which needs much less memory
+    Fail            //throw MemoryBudgetError
+};
+
+//kktMST with its working memory (the input graph is not counted) limited to tracker.budget()
+//fails fast with MemoryBudgetError, before any work, if even boruvkaMST would not fit
+Graph budgetedMST(const Graph& G, MemoryTracker& tracker,
+                  OnBudgetExceeded policy = OnBudgetExceeded::Fallback);
+
+#endif      // MEMORY_TRACKER_HPP_
@@ -0,0 +1,292 @@
+#include "mst_cache.hpp"
+#include "boruvka.hpp"
+#include "graph.hpp"
+#include "thread_pool.hpp"
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <optional>
+#include <utility>
+
+namespace {
+
+//vertices per thread below which hashing stays on one thread
+constexpr Index MIN_VERTICES_PER_THREAD = 1 << 14;
+
+//file header of MSTCache::save
+constexpr char MAGIC[4] = {'M', 'S', 'T', 'C'};
+constexpr std::uint32_t FORMAT_VERSION = 1;
+
+//splitmix64 finalizer
+std::uint64_t mix(std::uint64_t x) {
+    x += 0x9e3779b97f4a7c15ULL;
+    x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+    return x ^ (x >> 31);
+}
+
+std::uint64_t weightBits(Weight w) {
+    if (w == 0) w = 0;                                  //-0.0 and 0.0 hash alike
+    std::uint64_t bits = 0;
+    std::memcpy(&bits, &w, sizeof(Weight));
+    return bits;
+}
+
+//hash of one edge, the same for both orientations and any edge ID
+std::uint64_t edgeHash(const Graph::Edge& e) {
+    auto a = static_cast<std::uint64_t>(std::min(e.v1, e.v2));
+    auto b = static_cast<std::uint64_t>(std::max(e.v1, e.v2));
+    return mix(mix(mix(a) ^ b) ^ weightBits(e.weight));
+}
+
+bool sameEdge(const Graph::Edge& a, const Graph::Edge& b) {
+    return a.weight == b.weight && std::minmax(a.v1, a.v2) == std::minmax(b.v1, b.v2);
+}
+
+//order-insensitive sum of edge hashes and number of edges (self-loops count twice)
+struct Summary {
+    std::uint64_t hashSum {0};
+    std::uint64_t numEdges {0};
+
+    std::uint64_t fingerprint() const {
+        return mix(hashSum + mix(numEdges));
+    }
+};
+
+Summary summarize(const Graph& G, int numThreads) {
+    Index n = G.numVertices();
+    ThreadPool& pool = globalThreadPool();
+    if (numThreads <= 0) numThreads = pool.numThreads();
+    numThreads = static_cast<int>(std::clamp<Index>(n / MIN_VERTICES_PER_THREAD, 1, numThreads));
+    std::vector<Summary> partial(numThreads);
+    auto worker = [&](int t) {
+        Index lo = static_cast<Index>(static_cast<long long>(n) * t / numThreads);
+        Index hi = static_cast<Index>(static_cast<long long>(n) * (t + 1) / numThreads);
+        Summary s;
+        for (Index u = lo; u < hi; ++u) {
+            for (const auto& e : *G.neighbours(u)) {
+                if (u != e.v1) continue;                //avoid duplicate edge
+                s.hashSum += edgeHash(e);
+                ++s.numEdges;
+            }
+        }
+        partial[t] = s;
+    };
+    pool.parallelParts(numThreads, worker);
+    Summary total;
+    for (const auto& s : partial) {
+        total.hashSum += s.hashSum;
+        total.numEdges += s.numEdges;
+    }
+    return total;
+}
+
+//cached forest edges expressed with the edges (and IDs) of G
+//nullopt if one of them is not in G (a fingerprint collision)
+std::optional<std::vector<Graph::Edge>> matchEdges(const Graph& G, const std::vector<Graph::Edge>& forest) {
+    std::vector<Graph::Edge> result;
+    result.reserve(forest.size());
+    //usual case: G is the cached graph again, IDs still match
+    for (const auto& e : forest) {
+        if (!G.hasEdgeID(e.edgeId) || !sameEdge(G.edgeByID(e.edgeId), e)) break;
+        result.push_back(G.edgeByID(e.edgeId));
+    }
+    if (result.size() == forest.size()) return result;
+
+    //otherwise look every edge up by endpoints and weight (lowest ID among parallel copies)
+    result.clear();
+    std::unordered_multimap<std::uint64_t, Graph::Edge> byHash;
+    byHash.reserve(forest.size());
+    for (const auto& e : forest) byHash.insert({edgeHash(e), e});
+    std::unordered_map<std::uint64_t, Graph::Edge> match;       //by hash of the cached edge
+    for (Index u = 0; u < G.numVertices(); ++u) {
+        for (const auto& e : *G.neighbours(u)) {
+            if (u != e.v1) continue;
+            std::uint64_t h = edgeHash(e);
+            auto range = byHash.equal_range(h);
+            for (auto it = range.first; it != range.second; ++it) {
+                if (!sameEdge(it->second, e)) continue;
+                auto [pos, inserted] = match.insert({h, e});
+                if (!inserted && e.edgeId < pos->second.edgeId) pos->second = e;
+            }
+        }
+    }
+    for (const auto& e : forest) {
+        auto it = match.find(edgeHash(e));
+        if (it == match.end()) return std::nullopt;
+        result.push_back(it->second);
+    }
+    return result;
+}
+
+template <typename T>
+void writeValue(std::ofstream& out, const T& value) {
+    out.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+template <typename T>
+bool readValue(std::ifstream& in, T& value) {
+    return static_cast<bool>(in.read(reinterpret_cast<char*>(&value), sizeof(T)));
+}
+
+}  // namespace
+
+std::uint64_t graphFingerprint(const Graph& G, int numThreads) {
+    return summarize(G, numThreads).fingerprint();
+}
+
+MSTCache::MSTCache(std::size_t capacity, Engine engine)
+    : maxEntries(std::max<std::size_t>(capacity, 1)),
+      engine(engine ? std::move(engine) : Engine([](const Graph& G) { return boruvkaMST(G); })) {}
+
+Graph MSTCache::get(const Graph& G) {
+    Summary s = summarize(G, 0);
+    std::uint64_t fingerprint = s.fingerprint();
+    std::optional<std::vector<Graph::Edge>> cached;
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        auto it = index.find(fingerprint);
+        if (it != index.end() && it->second->numEdges == s.numEdges) {
+            entries.splice(entries.begin(), entries, it->second);     //now most recently used
+            cached = it->second->forest;
+        }
+    }
+    //a cached forest with an edge G doesn't have belongs to another graph: a miss
+    if (cached) cached = matchEdges(G, *cached);
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        ++(cached ? hitCount : missCount);
+    }
+    if (cached) return Graph(G.numVertices(), std::move(*cached));
+
+    //compute without holding the lock, other lookups can go on meanwhile
+    Graph F = engine(G);
+    Entry entry {fingerprint, s.numEdges, {}};
+    for (Index u = 0; u < F.numVertices(); ++u) {
+        for (const auto& e : *F.neighbours(u)) {
+            if (u == e.v1) entry.forest.push_back(e);
+        }
+    }
+    std::lock_guard<std::mutex> guard(lock);
+    store(std::move(entry));
+    return F;
+}
+
+bool MSTCache::contains(const Graph& G) const {
+    Summary s = summarize(G, 0);
+    std::lock_guard<std::mutex> guard(lock);
+    auto it = index.find(s.fingerprint());
+    return it != index.end() && it->second->numEdges == s.numEdges;
+}
+
+std::size_t MSTCache::hits() const {
+    std::lock_guard<std::mutex> guard(lock);
+    return hitCount;
+}
+
+std::size_t MSTCache::misses() const {
+    std::lock_guard<std::mutex> guard(lock);
+    return missCount;
+}
+
+std::size_t MSTCache::size() const {
+    std::lock_guard<std::mutex> guard(lock);
+    return entries.size();
+}
+
+std::size_t MSTCache::capacity() const {
+    return maxEntries;
+}
+
+void MSTCache::clear() {
+    std::lock_guard<std::mutex> guard(lock);
+    entries.clear();
+    index.clear();
+    hitCount = 0;
+    missCount = 0;
+}
+
+bool MSTCache::save(const std::string& file) const {
+    std::ofstream out {file, std::ios::binary};
+    if (!out) {
+        std::cerr << file << " could not be opened\n";
+        return false;
+    }
+    std::lock_guard<std::mutex> guard(lock);
+    out.write(MAGIC, sizeof(MAGIC));
+    writeValue(out, FORMAT_VERSION);
+    writeValue(out, static_cast<std::uint8_t>(sizeof(Weight)));
+    writeValue(out, static_cast<std::uint8_t>(sizeof(Index)));
+    writeValue(out, static_cast<std::uint64_t>(entries.size()));
+    //least recently used first, so load restores the same order
+    for (auto it = entries.rbegin(); it != entries.rend(); ++it) {
+        writeValue(out, it->fingerprint);
+        writeValue(out, it->numEdges);
+        writeValue(out, static_cast<std::uint64_t>(it->forest.size()));
+        for (const auto& e : it->forest) {
+            writeValue(out, e.weight);
+            writeValue(out, e.v1);
+            writeValue(out, e.v2);
+            writeValue(out, e.edgeId);
+        }
+    }
+    return static_cast<bool>(out);
+}
+
+bool MSTCache::load(const std::string& file) {
+    std::ifstream in {file, std::ios::binary};
+    if (!in) {
+        std::cerr << file << " could not be opened\n";
+        return false;
+    }
+    char magic[sizeof(MAGIC)];
+    std::uint32_t version = 0;
+    std::uint8_t weightSize = 0;
+    std::uint8_t indexSize = 0;
+    std::uint64_t count = 0;
+    if (!in.read(magic, sizeof(magic)) || !std::equal(magic, magic + sizeof(magic), MAGIC) ||
+        !readValue(in, version) || version != FORMAT_VERSION ||
+        !readValue(in, weightSize) || weightSize != sizeof(Weight) ||
+        !readValue(in, indexSize) || indexSize != sizeof(Index) || !readValue(in, count)) {
+        return false;
+    }
+    //read everything before touching the cache
+    std::vector<Entry> loaded;
+    for (std::uint64_t i = 0; i < count; ++i) {
+        Entry entry {};
+        std::uint64_t forestSize = 0;
+        if (!readValue(in, entry.fingerprint) || !readValue(in, entry.numEdges) ||
+            !readValue(in, forestSize) || forestSize > entry.numEdges) {
+            return false;
+        }
+        entry.forest.resize(forestSize);
+        for (auto& e : entry.forest) {
+            if (!readValue(in, e.weight) || !readValue(in, e.v1) || !readValue(in, e.v2) ||
+                !readValue(in, e.edgeId)) {
+                return false;
+            }
+        }
+        loaded.push_back(std::move(entry));
+    }
+    std::lock_guard<std::mutex> guard(lock);
+    for (auto& entry : loaded) store(std::move(entry));
+    return true;
+}
+
+
+//helper functions
+
+void MSTCache::store(Entry entry) {
+    auto it = index.find(entry.fingerprint);
+    if (it != index.end()) {
+        entries.erase(it->second);
+        index.erase(it);
+    }
+    entries.push_front(std::move(entry));
+    index[entries.front().fingerprint] = entries.begin();
+    while (entries.size() > maxEntries) {
+        index.erase(entries.back().fingerprint);
+        entries.pop_back();
+    }
+}
@@ -0,0 +1,72 @@
+#ifndef MST_CACHE_HPP_
+#define MST_CACHE_HPP_
+
+#include "graph.hpp"
+#include <cstdint>
+#include <cstddef>
+#include <functional>
+#include <list>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+//64-bit fingerprint of the edge multiset of G: each edge {v1, v2, weight} is hashed on its own
+//(endpoint order ignored) and the hashes are added up, so the order of the edges, their IDs and
+//trailing isolated vertices (vertex count padding) do not change the fingerprint
+//the vertices are split into numThreads parts run on globalThreadPool() (0: one per pool thread)
+std::uint64_t graphFingerprint(const Graph& G, int numThreads = 0);
+
+//LRU cache of minimum spanning forests keyed by graphFingerprint
+//get(G) returns the cached forest when a graph with the same edges was seen before, otherwise
+//runs the engine and stores the result. Edge IDs of a returned forest always refer to G; when
+//G lists equal-weight edges in another order than the cached graph, the cached choice among
+//the ties is kept (still a minimum spanning forest of G). a cached forest with an edge G lacks
+//(fingerprint collision) counts as a miss: it is recomputed and replaces the entry.
+//get is safe to call from many threads.
+class MSTCache {
+    public:
+    using Engine = std::function<Graph(const Graph&)>;
+
+    //keep at most capacity forests, computed with engine (boruvkaMST by default)
+    explicit MSTCache(std::size_t capacity, Engine engine = {});
+
+    //minimum spanning forest of G, from the cache if possible
+    Graph get(const Graph& G);
+    //is a forest for G cached?
+    bool contains(const Graph& G) const;
+
+    std::size_t hits() const;
+    std::size_t misses() const;
+    std::size_t size() const;
+    std::size_t capacity() const;
+    //drop all entries and reset the counters
+    void clear();
+
+    //write all entries (least recently used first) to a compact binary file
+    //returns false if the file could not be written
+    bool save(const std::string& file) const;
+    //add the entries of a file written by save (with the same Weight and Index types)
+    //returns false, leaving the cache unchanged, if the file is missing or malformed
+    bool load(const std::string& file);
+
+    private:
+    struct Entry {
+        std::uint64_t fingerprint;
+        std::uint64_t numEdges;             //edges in the graph, guards against collisions
+        std::vector<Graph::Edge> forest;    //forest edges with the IDs of the cached graph
+    };
+
+    std::size_t maxEntries;
+    Engine engine;
+    std::list<Entry> entries;               //most recently used first
+    std::unordered_map<std::uint64_t, std::list<Entry>::iterator> index;
+    std::size_t hitCount {0};
+    std::size_t missCount {0};
+    mutable std::mutex lock;
+
+    //insert or refresh an entry and evict beyond capacity (lock held)
+    void store(Entry entry);
+};
+
+#endif      // MST_CACHE_HPP_
@@ -0,0 +1,53 @@
+#ifndef MST_CONTROL_HPP_
+#define MST_CONTROL_HPP_
+
+#include "types.hpp"
+#include <atomic>
+#include <functional>
+#include <stdexcept>
+
+//progress of a running engine, reported at every checkpoint
+struct MSTProgress {
+    const char* engine;     //"boruvka" or "kkt"
+    Index components;       //boruvka: components left; kkt: vertices of the current subproblem
+    int depth;              //kkt recursion depth (0 for boruvka)
+    int round;              //boruvka round (0 for kkt)
+};
+
+//thrown by a checkpoint once cancellation was requested
+class MSTCancelled : public std::runtime_error {
+    public:
+    MSTCancelled() : std::runtime_error("MST computation cancelled") {}
+};
+
+//Cooperative cancellation and progress reporting for a running engine.
+//Engines call checkpoint between Borůvka rounds and on every KKT subproblem; engines run
+//without a control skip the checkpoints entirely.
+class MSTControl {
+    public:
+    using ProgressCallback = std::function<void(const MSTProgress&)>;
+
+    MSTControl() = default;
+    explicit MSTControl(ProgressCallback onProgress) : onProgress(std::move(onProgress)) {}
+
+    //request cancellation, the engine stops at its next checkpoint (safe from any thread)
+    void cancel() {
+        stop.store(true, std::memory_order_relaxed);
+    }
+
+    bool cancelled() const {
+        return stop.load(std::memory_order_relaxed);
+    }
+
+    //report progress, then throw MSTCancelled if cancellation was requested
+    void checkpoint(const MSTProgress& progress) const {
+        if (onProgress) onProgress(progress);
+        if (cancelled()) throw MSTCancelled();
+    }
+
+    private:
+    std::atomic<bool> stop {false};
+    ProgressCallback onProgress;
+};
+
+#endif      // MST_CONTROL_HPP_
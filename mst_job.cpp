@@ -0,0 +1,88 @@
+#include "mst_job.hpp"
+#include "boruvka.hpp"
+#include "kkt.hpp"
+#include "graph.hpp"
+#include <algorithm>
+#include <chrono>
+
+MSTExecutor::MSTExecutor(int numThreads) {
+    if (numThreads <= 0) numThreads = static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+    for (int t = 0; t < numThreads; ++t) workers.emplace_back(&MSTExecutor::work, this);
+}
+
+MSTExecutor::~MSTExecutor() {
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        stopping = true;
+    }
+    wake.notify_all();
+    for (auto& worker : workers) worker.join();
+}
+
+void MSTExecutor::post(std::function<void()> task) {
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        tasks.push_back(std::move(task));
+    }
+    wake.notify_one();
+}
+
+int MSTExecutor::numThreads() const {
+    return static_cast<int>(workers.size());
+}
+
+void MSTExecutor::work() {
+    while (true) {
+        std::function<void()> task;
+        {
+            std::unique_lock<std::mutex> guard(lock);
+            wake.wait(guard, [this] { return stopping || !tasks.empty(); });
+            if (tasks.empty()) return;                  //stopping and drained
+            task = std::move(tasks.front());
+            tasks.pop_front();
+        }
+        task();
+    }
+}
+
+MSTExecutor& sharedExecutor() {
+    static MSTExecutor executor;
+    return executor;
+}
+
+MSTJob::MSTJob(std::shared_ptr<MSTControl> control, std::shared_future<Graph> result)
+    : control(std::move(control)), result(std::move(result)) {}
+
+Graph MSTJob::get() {
+    return result.get();
+}
+
+void MSTJob::wait() const {
+    result.wait();
+}
+
+bool MSTJob::ready() const {
+    return result.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+}
+
+void MSTJob::cancel() {
+    control->cancel();
+}
+
+MSTJob submitMST(std::shared_ptr<const Graph> G, MSTEngine engine,
+                 MSTControl::ProgressCallback onProgress, MSTExecutor& executor) {
+    auto control = std::make_shared<MSTControl>(std::move(onProgress));
+    auto task = std::make_shared<std::packaged_task<Graph()>>([G, engine, control]() {
+        if (control->cancelled()) throw MSTCancelled();     //cancelled while queued
+        if (engine == MSTEngine::KKT) return kktMST(*G, *control);
+        return boruvkaMST(*G, *control);
+    });
+    MSTJob job(control, task->get_future().share());
+    executor.post([task]() { (*task)(); });
+    return job;
+}
+
+MSTJob submitMST(Graph G, MSTEngine engine,
+                 MSTControl::ProgressCallback onProgress, MSTExecutor& executor) {
+    return submitMST(std::make_shared<const Graph>(std::move(G)), engine, std::move(onProgress), executor);
+}
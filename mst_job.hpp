@@ -0,0 +1,69 @@
+#ifndef MST_JOB_HPP_
+#define MST_JOB_HPP_
+
+#include "graph.hpp"
+#include "mst_control.hpp"
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+//fixed set of worker threads running queued tasks in FIFO order
+class MSTExecutor {
+    public:
+    //numThreads workers (0: hardware concurrency)
+    explicit MSTExecutor(int numThreads = 0);
+    //finishes the queued tasks, then joins the workers
+    ~MSTExecutor();
+    MSTExecutor(const MSTExecutor&) = delete;
+    MSTExecutor& operator=(const MSTExecutor&) = delete;
+
+    void post(std::function<void()> task);
+    int numThreads() const;
+
+    private:
+    std::vector<std::thread> workers;
+    std::deque<std::function<void()>> tasks;
+    std::mutex lock;
+    std::condition_variable wake;
+    bool stopping {false};
+
+    void work();
+};
+
+//executor shared by all jobs that do not name one
+MSTExecutor& sharedExecutor();
+
+enum class MSTEngine { Boruvka, KKT };
+
+//handle of an MST computation running on an executor
+class MSTJob {
+    public:
+    MSTJob(std::shared_ptr<MSTControl> control, std::shared_future<Graph> result);
+
+    //wait for the forest, rethrows MSTCancelled (or any error of the engine)
+    Graph get();
+    //block until the job has finished (or stopped)
+    void wait() const;
+    //has the job finished (or stopped)?
+    bool ready() const;
+    //ask the job to stop at its next checkpoint, before it starts if it is still queued
+    void cancel();
+
+    private:
+    std::shared_ptr<MSTControl> control;
+    std::shared_future<Graph> result;
+};
+
+//run engine on G asynchronously; onProgress is called from the worker thread at every checkpoint
+MSTJob submitMST(std::shared_ptr<const Graph> G, MSTEngine engine,
+                 MSTControl::ProgressCallback onProgress = {}, MSTExecutor& executor = sharedExecutor());
+//same, taking ownership of G
+MSTJob submitMST(Graph G, MSTEngine engine,
+                 MSTControl::ProgressCallback onProgress = {}, MSTExecutor& executor = sharedExecutor());
+
+#endif      // MST_JOB_HPP_
@@ -0,0 +1,322 @@
+#include "numa_mst.hpp"
+#include "spanning_forest.hpp"
+#include "union_find.hpp"
+#include "graph.hpp"
+#include <sched.h>
+#include <algorithm>
+#include <barrier>
+#include <cctype>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <set>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+namespace {
+
+//edges per worker below which fewer workers are used
+constexpr std::size_t MIN_EDGES_PER_THREAD = 1 << 14;
+constexpr std::size_t PAGE_SIZE = 4096;
+
+//cheapest edge of a component (id -1: none); a trivial type, so allocating an array of
+//them leaves the pages untouched until a worker writes them
+struct Candidate {
+    Weight weight;
+    Index id;
+    Index a;                //component labels of the endpoints
+    Index b;
+};
+
+//(weight, edge ID) order, no candidate is the heaviest
+bool lighter(const Candidate& x, const Candidate& y) {
+    if (x.id == -1) return false;
+    if (y.id == -1) return true;
+    if (x.weight != y.weight) return x.weight < y.weight;
+    return x.id < y.id;
+}
+
+//array whose pages are placed by the first thread writing them
+template <typename T>
+using Array = std::unique_ptr<T[]>;
+
+template <typename T>
+Array<T> uninitialized(std::size_t size) {
+    return std::make_unique_for_overwrite<T[]>(size);
+}
+
+//first touch every page with index = slot (mod stride) of a block of bytes
+void touchPages(void* block, std::size_t bytes, std::size_t slot, std::size_t stride) {
+    auto* p = static_cast<volatile char*>(block);
+    for (std::size_t offset = slot * PAGE_SIZE; offset < bytes; offset += stride * PAGE_SIZE) p[offset] = 0;
+}
+
+//what one worker owns: a vertex range, the edges leaving it and its cheapest-edge buffer
+struct WorkerData {
+    int cpu {-1};
+    int node {0};           //position in the list of used nodes
+    int rank {0};           //position among the workers of its node
+    Index firstVertex {0};
+    Index lastVertex {0};   //exclusive
+    std::size_t numEdges {0};
+    Array<Weight> weight;
+    Array<Index> id;
+    Array<Index> a;         //endpoint labels, relabelled to components every round
+    Array<Index> b;
+    Array<Candidate> best;  //cheapest edge per component seen by this worker
+};
+
+std::vector<int> allowedCpus() {
+    std::vector<int> cpus;
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    if (sched_getaffinity(0, sizeof(set), &set) == 0) {
+        for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu) {
+            if (CPU_ISSET(cpu, &set)) cpus.push_back(cpu);
+        }
+    }
+    if (cpus.empty()) {
+        unsigned count = std::max(1u, std::thread::hardware_concurrency());
+        for (unsigned cpu = 0; cpu < count; ++cpu) cpus.push_back(static_cast<int>(cpu));
+    }
+    return cpus;
+}
+
+}  // namespace
+
+std::vector<int> parseCpuList(const std::string& list) {
+    std::vector<int> cpus;
+    std::stringstream items {list};
+    std::string item;
+    while (std::getline(items, item, ',')) {
+        item.erase(std::remove_if(item.begin(), item.end(), [](unsigned char c) { return std::isspace(c); }),
+                   item.end());
+        if (item.empty()) continue;
+        std::size_t dash = item.find('-');
+        try {
+            std::size_t used = 0;
+            int first = std::stoi(item.substr(0, dash), &used);
+            if (used != (dash == std::string::npos ? item.size() : dash)) return {};
+            int last = first;
+            if (dash != std::string::npos) {
+                last = std::stoi(item.substr(dash + 1), &used);
+                if (used != item.size() - dash - 1) return {};
+            }
+            if (first < 0 || last < first) return {};
+            for (int cpu = first; cpu <= last; ++cpu) cpus.push_back(cpu);
+        }
+        catch (const std::exception&) {
+            return {};
+        }
+    }
+    return cpus;
+}
+
+NumaTopology numaTopology() {
+    namespace fs = std::filesystem;
+    std::vector<int> allowed = allowedCpus();
+    std::set<int> allowedSet(allowed.begin(), allowed.end());
+    //node directories, in node order
+    std::vector<std::pair<int, fs::path>> nodes;
+    std::error_code ec;
+    for (fs::directory_iterator it {"/sys/devices/system/node", ec}; !ec && it != fs::directory_iterator {};
+         it.increment(ec)) {
+        std::string name = it->path().filename().string();
+        if (name.size() <= 4 || name.compare(0, 4, "node") != 0) continue;
+        if (!std::all_of(name.begin() + 4, name.end(), [](unsigned char c) { return std::isdigit(c); })) continue;
+        nodes.push_back({std::stoi(name.substr(4)), it->path()});
+    }
+    std::sort(nodes.begin(), nodes.end());
+
+    NumaTopology topology;
+    for (const auto& [node, path] : nodes) {
+        std::ifstream in {path / "cpulist"};
+        std::string list;
+        if (!in || !std::getline(in, list)) continue;
+        std::vector<int> cpus;
+        for (int cpu : parseCpuList(list)) {
+            if (allowedSet.count(cpu)) cpus.push_back(cpu);
+        }
+        if (!cpus.empty()) topology.cpus.push_back(std::move(cpus));
+    }
+    if (topology.cpus.empty()) topology.cpus.push_back(allowed);
+    return topology;
+}
+
+bool pinCurrentThread(int cpu) {
+    if (cpu < 0 || cpu >= CPU_SETSIZE) return false;
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cpu, &set);
+    return sched_setaffinity(0, sizeof(set), &set) == 0;
+}
+
+SpanningForest numaBoruvkaForest(const Graph& G, const NumaOptions& options) {
+    Index n = G.numVertices();
+    SpanningForest forest(n);
+    if (n <= 1) return forest;
+
+    //CPUs node by node, workers spread evenly over them
+    NumaTopology topology = numaTopology();
+    std::vector<std::pair<int, int>> slots;             //(cpu, node)
+    for (int node = 0; node < topology.numNodes(); ++node) {
+        for (int cpu : topology.cpus[node]) slots.push_back({cpu, node});
+    }
+    std::vector<std::size_t> degreePrefix(n + 1, 0);
+    for (Index v = 0; v < n; ++v) degreePrefix[v + 1] = degreePrefix[v] + G.neighbours(v)->size();
+    std::size_t totalDegree = degreePrefix[n];
+    int numThreads = options.numThreads > 0 ? options.numThreads : static_cast<int>(slots.size());
+    numThreads = static_cast<int>(std::clamp<std::size_t>(totalDegree / 2 / MIN_EDGES_PER_THREAD, 1, numThreads));
+
+    std::vector<WorkerData> data(numThreads);
+    std::vector<int> nodeIndex(topology.numNodes(), -1);
+    std::vector<std::vector<int>> nodeWorkers;          //workers of every used node
+    for (int w = 0; w < numThreads; ++w) {
+        auto [cpu, node] = slots[static_cast<std::size_t>(w) * slots.size() / numThreads];
+        if (nodeIndex[node] == -1) {
+            nodeIndex[node] = static_cast<int>(nodeWorkers.size());
+            nodeWorkers.emplace_back();
+        }
+        data[w].cpu = cpu;
+        data[w].node = nodeIndex[node];
+        data[w].rank = static_cast<int>(nodeWorkers[data[w].node].size());
+        nodeWorkers[data[w].node].push_back(w);
+        //vertex ranges with about the same number of adjacency entries
+        auto split = [&](int t) {
+            std::size_t target = totalDegree * t / numThreads;
+            return static_cast<Index>(std::lower_bound(degreePrefix.begin(), degreePrefix.end(), target) -
+                                      degreePrefix.begin());
+        };
+        data[w].firstVertex = (w == 0) ? 0 : split(w);
+        data[w].lastVertex = (w == numThreads - 1) ? n : split(w + 1);
+    }
+    std::vector<Array<Candidate>> nodeBest(nodeWorkers.size());     //per-node reduction buffers
+
+    //state of the serial merge step between rounds
+    UnionFind UF(0);
+    Index k = n;                            //number of components (labels 0 .. k - 1)
+    std::vector<Index> relabel;             //label of every component of the last round in this one
+    std::vector<Index> rootLabel;
+    bool done = false;
+    int round = 0;
+    int phase = 0;
+    auto mergeStep = [&]() noexcept {
+        if (phase++ % 2 == 0) return;       //after the scan, only the node reductions follow
+        UF.reset(k);
+        Index merged = 0;
+        for (Index c = 0; c < k; ++c) {
+            Candidate best {0, -1, 0, 0};
+            for (const auto& buffer : nodeBest) {
+                if (lighter(buffer[c], best)) best = buffer[c];
+            }
+            if (best.id == -1 || UF.sameSet(best.a, best.b)) continue;
+            UF.merge(best.a, best.b);
+            forest.add(G.edgeByID(best.id));
+            ++merged;
+        }
+        rootLabel.assign(k, -1);
+        relabel.resize(k);
+        Index next = 0;
+        for (Index c = 0; c < k; ++c) {
+            Index root = UF.find(c);
+            if (rootLabel[root] == -1) rootLabel[root] = next++;
+            relabel[c] = rootLabel[root];
+        }
+        k = next;
+        ++round;
+        done = (merged == 0 || k <= 1);
+    };
+    std::barrier setup(numThreads);
+    std::barrier sync(numThreads, mergeStep);
+
+    auto worker = [&](int w) {
+        WorkerData& own = data[w];
+        if (options.pinThreads) pinCurrentThread(own.cpu);
+        for (Index u = own.firstVertex; u < own.lastVertex; ++u) {
+            for (const auto& e : *G.neighbours(u)) {
+                if (u == e.v1 && e.v1 != e.v2) ++own.numEdges;     //avoid duplicate edge and self-loops
+            }
+        }
+        own.weight = uninitialized<Weight>(own.numEdges);
+        own.id = uninitialized<Index>(own.numEdges);
+        own.a = uninitialized<Index>(own.numEdges);
+        own.b = uninitialized<Index>(own.numEdges);
+        own.best = uninitialized<Candidate>(n);
+        if (own.rank == 0) nodeBest[own.node] = uninitialized<Candidate>(n);
+        setup.arrive_and_wait();
+        if (options.placement == NumaPlacement::Interleaved) {
+            //this worker places every numThreads-th page of every array
+            for (const auto& d : data) {
+                touchPages(d.weight.get(), d.numEdges * sizeof(Weight), w, numThreads);
+                touchPages(d.id.get(), d.numEdges * sizeof(Index), w, numThreads);
+                touchPages(d.a.get(), d.numEdges * sizeof(Index), w, numThreads);
+                touchPages(d.b.get(), d.numEdges * sizeof(Index), w, numThreads);
+                touchPages(d.best.get(), n * sizeof(Candidate), w, numThreads);
+            }
+            for (const auto& buffer : nodeBest) touchPages(buffer.get(), n * sizeof(Candidate), w, numThreads);
+            setup.arrive_and_wait();
+        }
+        //Local: the writes below are the first touch
+        std::size_t size = 0;
+        for (Index u = own.firstVertex; u < own.lastVertex; ++u) {
+            for (const auto& e : *G.neighbours(u)) {
+                if (u != e.v1 || e.v1 == e.v2) continue;
+                own.weight[size] = e.weight;
+                own.id[size] = e.edgeId;
+                own.a[size] = e.v1;
+                own.b[size] = e.v2;
+                ++size;
+            }
+        }
+        Candidate* nodeBuffer = nodeBest[own.node].get();
+        const std::vector<int>& neighbours = nodeWorkers[own.node];
+        while (true) {
+            //cheapest edge of every component among own edges, edges inside a component are dropped
+            Index components = k;
+            for (Index c = 0; c < components; ++c) own.best[c].id = -1;
+            std::size_t kept = 0;
+            for (std::size_t i = 0; i < size; ++i) {
+                Index a = own.a[i];
+                Index b = own.b[i];
+                if (round > 0) {
+                    a = relabel[a];
+                    b = relabel[b];
+                }
+                if (a == b) continue;
+                Candidate edge {own.weight[i], own.id[i], a, b};
+                own.weight[kept] = edge.weight;
+                own.id[kept] = edge.id;
+                own.a[kept] = a;
+                own.b[kept] = b;
+                ++kept;
+                if (lighter(edge, own.best[a])) own.best[a] = edge;
+                if (lighter(edge, own.best[b])) own.best[b] = edge;
+            }
+            size = kept;
+            sync.arrive_and_wait();
+            //reduce the buffers of this node's workers over a slice of the components
+            auto q = static_cast<Index>(neighbours.size());
+            Index lo = static_cast<Index>(static_cast<long long>(components) * own.rank / q);
+            Index hi = static_cast<Index>(static_cast<long long>(components) * (own.rank + 1) / q);
+            for (Index c = lo; c < hi; ++c) {
+                Candidate best {0, -1, 0, 0};
+                for (int x : neighbours) {
+                    if (lighter(data[x].best[c], best)) best = data[x].best[c];
+                }
+                nodeBuffer[c] = best;
+            }
+            sync.arrive_and_wait();         //the last worker to arrive runs mergeStep
+            if (done) break;
+        }
+    };
+
+    cpu_set_t callerMask;
+    bool restore = sched_getaffinity(0, sizeof(callerMask), &callerMask) == 0;
+    std::vector<std::thread> threads;
+    for (int w = 1; w < numThreads; ++w) threads.emplace_back(worker, w);
+    worker(0);
+    for (auto& th : threads) th.join();
+    if (restore) sched_setaffinity(0, sizeof(callerMask), &callerMask);
+    return forest;
+}
@@ -0,0 +1,51 @@
+#ifndef NUMA_MST_HPP_
+#define NUMA_MST_HPP_
+
+#include "graph.hpp"
+#include "spanning_forest.hpp"
+#include <string>
+#include <vector>
+
+//NUMA nodes and the CPUs of each that this process may run on
+//read from /sys/devices/system/node; without it (or with no usable node) a single node
+//holding every allowed CPU
+struct NumaTopology {
+    std::vector<std::vector<int>> cpus;     //cpus[node]: allowed CPUs of the node
+
+    int numNodes() const {
+        return static_cast<int>(cpus.size());
+    }
+};
+
+NumaTopology numaTopology();
+
+//CPUs of a sysfs cpulist such as "0-3,8,10-11", empty if malformed
+std::vector<int> parseCpuList(const std::string& list);
+
+//bind the calling thread to cpu, false if the system refuses
+bool pinCurrentThread(int cpu);
+
+//where the pages of the engine's arrays end up (Linux places a page on the node of the thread
+//that first writes it)
+enum class NumaPlacement {
+    Local,          //every array is first touched by the threads that work on it
+    Interleaved     //pages are first touched round-robin by the threads of all nodes
+};
+
+struct NumaOptions {
+    int numThreads {0};                         //<= 0: one per allowed CPU
+    NumaPlacement placement {NumaPlacement::Local};
+    bool pinThreads {true};                     //bind worker t to its CPU for the whole run
+};
+
+//parallel Boruvka that keeps its memory traffic on the local node
+//workers are spread over the nodes in proportion to their CPUs; each owns a range of vertices
+//(balanced by degree) and the edge arrays of those vertices, which it allocates and first
+//touches. every round, workers pick cheapest edges per component into their own buffer,
+//the workers of a node reduce those into a per-node buffer, and one thread merges the
+//node buffers (#nodes reads per component). components are relabelled densely each round,
+//so buffers shrink with the number of components. on a single node this is an ordinary
+//parallel Boruvka; ties are broken by edge ID, so the forest is the same as every engine's
+SpanningForest numaBoruvkaForest(const Graph& G, const NumaOptions& options = {});
+
+#endif      // NUMA_MST_HPP_
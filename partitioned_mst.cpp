@@ -0,0 +1,152 @@
+#include "partitioned_mst.hpp"
+#include "boruvka.hpp"
+#include "boruvka_kernel.hpp"
+#include "spanning_forest.hpp"
+#include "graph.hpp"
+#include <algorithm>
+#include <cerrno>
+#include <cstdint>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+#include <vector>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+namespace {
+
+using EdgeList = std::vector<Graph::Edge>;
+
+//edges [lo, hi) of E
+EdgeArrays slice(const EdgeArrays& E, std::size_t lo, std::size_t hi) {
+    EdgeArrays part;
+    part.weight.assign(E.weight.begin() + lo, E.weight.begin() + hi);
+    part.v1.assign(E.v1.begin() + lo, E.v1.begin() + hi);
+    part.v2.assign(E.v2.begin() + lo, E.v2.begin() + hi);
+    part.edgeId.assign(E.edgeId.begin() + lo, E.edgeId.begin() + hi);
+    return part;
+}
+
+bool writeAll(int fd, const void* data, std::size_t bytes) {
+    const char* p = static_cast<const char*>(data);
+    while (bytes > 0) {
+        ssize_t written = write(fd, p, bytes);
+        if (written < 0 && errno == EINTR) continue;
+        if (written <= 0) return false;
+        p += written;
+        bytes -= static_cast<std::size_t>(written);
+    }
+    return true;
+}
+
+bool readAll(int fd, void* data, std::size_t bytes) {
+    char* p = static_cast<char*>(data);
+    while (bytes > 0) {
+        ssize_t got = read(fd, p, bytes);
+        if (got < 0 && errno == EINTR) continue;
+        if (got <= 0) return false;
+        p += got;
+        bytes -= static_cast<std::size_t>(got);
+    }
+    return true;
+}
+
+//message on a pipe: the number of edges, then the edges as they are in memory
+bool sendEdges(int fd, const EdgeList& edges) {
+    std::uint64_t count = edges.size();
+    return writeAll(fd, &count, sizeof(count)) && writeAll(fd, edges.data(), count * sizeof(Graph::Edge));
+}
+
+bool receiveEdges(int fd, EdgeList& edges) {
+    std::uint64_t count = 0;
+    if (!readAll(fd, &count, sizeof(count))) return false;
+    edges.resize(count);
+    return readAll(fd, edges.data(), count * sizeof(Graph::Edge));
+}
+
+//work(0) .. work(count - 1), every one in a child process that sends its result through a pipe
+template <typename Work>
+std::vector<EdgeList> inWorkerProcesses(int count, Work work) {
+    std::vector<EdgeList> results(count);
+    std::vector<pid_t> pids(count, -1);
+    std::vector<int> fds(count, -1);
+    for (int i = 0; i < count; ++i) {
+        int ends[2];
+        if (pipe(ends) == 0) {
+            pid_t pid = fork();
+            if (pid == 0) {
+                close(ends[0]);
+                for (int j = 0; j < i; ++j) {
+                    if (fds[j] != -1) close(fds[j]);
+                }
+                bool sent = false;
+                try {
+                    sent = sendEdges(ends[1], work(i));
+                }
+                catch (...) {}
+                _exit(sent ? 0 : 1);                    //no atexit handlers or stream flushes of the parent
+            }
+            close(ends[1]);
+            if (pid > 0) {
+                pids[i] = pid;
+                fds[i] = ends[0];
+                continue;
+            }
+            close(ends[0]);
+        }
+        results[i] = work(i);                           //no process for this part: run it here
+    }
+    bool failed = false;
+    for (int i = 0; i < count; ++i) {
+        if (pids[i] == -1) continue;
+        bool received = receiveEdges(fds[i], results[i]);
+        close(fds[i]);
+        int status = 0;
+        while (waitpid(pids[i], &status, 0) < 0 && errno == EINTR) {}
+        if (!received || !WIFEXITED(status) || WEXITSTATUS(status) != 0) failed = true;
+    }
+    if (failed) throw std::runtime_error("partitioned MST: a worker process failed");
+    return results;
+}
+
+}  // namespace
+
+SpanningForest partitionedMSTForest(const Graph& G, const PartitionOptions& options) {
+    Index n = G.numVertices();
+    EdgeArrays edges(G);                                //each edge once, without self-loops
+    std::size_t m = static_cast<std::size_t>(edges.size());
+    int numPartitions = options.numPartitions;
+    if (numPartitions <= 0) numPartitions = static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+    numPartitions = static_cast<int>(std::clamp<std::size_t>(m, 1, numPartitions));
+    std::size_t fanIn = static_cast<std::size_t>(std::max(2, options.fanIn));
+
+    //local forests of the slices
+    std::vector<EdgeList> forests = inWorkerProcesses(numPartitions, [&](int p) {
+        return boruvkaSpanningForest(n, slice(edges, m * p / numPartitions, m * (p + 1) / numPartitions)).edges;
+    });
+    edges = EdgeArrays();
+
+    //merge tree: every level merges groups of fanIn forests in workers of their own
+    auto mergeGroup = [&forests, fanIn](std::size_t group) {
+        EdgeArrays merged;
+        for (std::size_t f = group * fanIn; f < std::min(forests.size(), (group + 1) * fanIn); ++f) {
+            for (const auto& e : forests[f]) {
+                merged.weight.push_back(e.weight);
+                merged.v1.push_back(e.v1);
+                merged.v2.push_back(e.v2);
+                merged.edgeId.push_back(e.edgeId);
+            }
+        }
+        return merged;
+    };
+    while (forests.size() > fanIn) {
+        int groups = static_cast<int>((forests.size() + fanIn - 1) / fanIn);
+        forests = inWorkerProcesses(groups, [&](int g) { return boruvkaSpanningForest(n, mergeGroup(g)).edges; });
+    }
+    return boruvkaSpanningForest(n, mergeGroup(0));
+}
+
+Graph partitionedMST(const Graph& G, const PartitionOptions& options) {
+    return partitionedMSTForest(G, options).toGraph();
+}
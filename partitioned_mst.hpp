@@ -0,0 +1,28 @@
+#ifndef PARTITIONED_MST_HPP_
+#define PARTITIONED_MST_HPP_
+
+#include "graph.hpp"
+#include "spanning_forest.hpp"
+
+//options for the partitioned MST
+struct PartitionOptions {
+    int numPartitions {0};      //worker processes for the local forests, <= 0: one per hardware thread
+    int fanIn {4};              //forests merged by one process on each level of the merge tree (>= 2)
+};
+
+//Partitioned MST in worker processes, a single-machine stand-in for a multi-node run
+//the edge list (each edge once, without self-loops) is cut into numPartitions consecutive
+//slices; a forked worker per slice computes the minimum spanning forest of its slice with
+//boruvkaSpanningForest on edge arrays (no Graph is built) and sends it back through a pipe.
+//the input reaches the workers copy-on-write through fork. by the cycle property the local
+//forests contain the global one, so they are merged hierarchically: groups of fanIn forests
+//go to a new worker each, until at most fanIn remain, which the calling process merges.
+//edges keep their IDs and ties are broken by ID, so the forest is the one of boruvkaMST on G.
+//a part whose process can't be started runs in the calling process; a worker that fails
+//throws std::runtime_error. fork copies only the calling thread: don't call it while other
+//threads may hold locks
+SpanningForest partitionedMSTForest(const Graph& G, const PartitionOptions& options = {});
+//same forest as a Graph
+Graph partitionedMST(const Graph& G, const PartitionOptions& options = {});
+
+#endif      // PARTITIONED_MST_HPP_
@@ -0,0 +1,132 @@
+#include "radix_kruskal.hpp"
+#include "spanning_forest.hpp"
+#include "union_find.hpp"
+#include "graph.hpp"
+#include "thread_pool.hpp"
+#include <algorithm>
+#include <array>
+#include <vector>
+
+namespace {
+
+constexpr int DIGIT_BITS = 8;
+constexpr std::size_t NUM_BUCKETS = std::size_t {1} << DIGIT_BITS;
+//edges per thread below which a pass stays on one thread
+constexpr std::size_t MIN_EDGES_PER_THREAD = 1 << 16;
+//largest ID range (per edge) still sorted by one counting pass instead of ID digits
+constexpr std::size_t ID_BUCKETS_PER_EDGE = 4;
+
+using Histogram = std::array<std::size_t, NUM_BUCKETS>;
+
+//digit of the sort key in the given pass: edge ID digits first (least significant), then the weight key
+std::size_t digit(const Graph::Edge& e, int pass, int idPasses) {
+    if (pass < idPasses) {
+        return (static_cast<std::uint64_t>(e.edgeId) >> (DIGIT_BITS * pass)) & (NUM_BUCKETS - 1);
+    }
+    return (weightKey(e.weight) >> (DIGIT_BITS * (pass - idPasses))) & (NUM_BUCKETS - 1);
+}
+
+//run f(t) for t = 0 .. numThreads - 1 on the library's pool
+template <typename F>
+void runThreads(int numThreads, F&& f) {
+    globalThreadPool().parallelParts(numThreads, f);
+}
+
+//stable LSD radix sort of edges, buffer is scratch of the same size
+void radixSort(std::vector<Graph::Edge>& edges, std::vector<Graph::Edge>& buffer, int numThreads) {
+    std::size_t m = edges.size();
+    Index maxId = 0;
+    for (const auto& e : edges) maxId = std::max(maxId, e.edgeId);
+    int idPasses = (std::bit_width(static_cast<std::uint64_t>(maxId)) + DIGIT_BITS - 1) / DIGIT_BITS;
+    //IDs of a Graph are (nearly) 0 .. m - 1: one counting sort by ID replaces the ID digits
+    if (static_cast<std::size_t>(maxId) < ID_BUCKETS_PER_EDGE * m) {
+        std::vector<std::size_t> start(static_cast<std::size_t>(maxId) + 2, 0);
+        for (const auto& e : edges) ++start[e.edgeId + 1];
+        for (std::size_t id = 0; id + 1 < start.size(); ++id) start[id + 1] += start[id];
+        for (const auto& e : edges) buffer[start[e.edgeId]++] = e;
+        edges.swap(buffer);
+        idPasses = 0;
+    }
+    int passes = idPasses + static_cast<int>(sizeof(WeightKey));
+
+    //one thread: the histograms of all passes come from a single read, they don't depend on order
+    std::vector<Histogram> all;
+    if (numThreads == 1) {
+        all.assign(passes, Histogram {});
+        for (const auto& e : edges) {
+            for (int pass = 0; pass < passes; ++pass) ++all[pass][digit(e, pass, idPasses)];
+        }
+    }
+    std::vector<Histogram> count(numThreads);
+    auto chunk = [m, numThreads](int t) {
+        return std::pair {m * t / numThreads, m * (t + 1) / numThreads};
+    };
+    for (int pass = 0; pass < passes; ++pass) {
+        if (numThreads == 1) {
+            count[0] = all[pass];
+        }
+        else {
+            runThreads(numThreads, [&](int t) {
+                auto [lo, hi] = chunk(t);
+                count[t].fill(0);
+                for (std::size_t i = lo; i < hi; ++i) ++count[t][digit(edges[i], pass, idPasses)];
+            });
+        }
+        //all edges share this digit: nothing moves
+        std::size_t first = digit(edges[0], pass, idPasses);
+        std::size_t same = 0;
+        for (const auto& c : count) same += c[first];
+        if (same == m) continue;
+        //start of every (digit, thread) block: digits in order, threads in order within a digit
+        std::size_t offset = 0;
+        for (std::size_t d = 0; d < NUM_BUCKETS; ++d) {
+            for (auto& c : count) {
+                std::size_t size = c[d];
+                c[d] = offset;
+                offset += size;
+            }
+        }
+        runThreads(numThreads, [&](int t) {
+            auto [lo, hi] = chunk(t);
+            auto& next = count[t];
+            for (std::size_t i = lo; i < hi; ++i) buffer[next[digit(edges[i], pass, idPasses)]++] = edges[i];
+        });
+        edges.swap(buffer);
+    }
+}
+
+}  // namespace
+
+SpanningForest radixKruskalForest(const Graph& G, int numThreads) {
+    Index n = G.numVertices();
+    SpanningForest forest(n);
+    std::vector<Graph::Edge> edges;
+    for (Index u = 0; u < n; ++u) {
+        for (const auto& e : *G.neighbours(u)) {
+            if (u == e.v1 && e.v1 != e.v2) edges.push_back(e);     //avoid duplicate edge and self-loops
+        }
+    }
+    if (edges.empty()) return forest;
+
+    if (numThreads <= 0) numThreads = globalThreadPool().numThreads();
+    numThreads = static_cast<int>(std::clamp<std::size_t>(edges.size() / MIN_EDGES_PER_THREAD, 1, numThreads));
+    std::vector<Graph::Edge> buffer(edges.size());
+    radixSort(edges, buffer, numThreads);
+    buffer = std::vector<Graph::Edge>();
+
+    forest.edges.reserve(n - 1);
+    UnionFind UF(n);
+    for (const auto& e : edges) {
+        if (static_cast<Index>(forest.edges.size()) == n - 1) break;   //spanning tree complete
+        Index root1 = UF.find(e.v1);
+        Index root2 = UF.find(e.v2);
+        if (root1 == root2) continue;
+        UF.merge(root1, root2);
+        forest.add(e);
+    }
+    return forest;
+}
+
+Graph radixKruskalMST(const Graph& G, int numThreads) {
+    return radixKruskalForest(G, numThreads).toGraph();
+}
@@ -0,0 +1,39 @@
+#ifndef RADIX_KRUSKAL_HPP_
+#define RADIX_KRUSKAL_HPP_
+
+#include "graph.hpp"
+#include "spanning_forest.hpp"
+#include <bit>
+#include <cstdint>
+#include <type_traits>
+
+//unsigned integer with the width of Weight
+using WeightKey = std::conditional_t<sizeof(Weight) <= 4, std::uint32_t, std::uint64_t>;
+
+//order-preserving key of a weight: a < b exactly when weightKey(a) < weightKey(b)
+//floating point: flip the sign bit of positive values and all bits of negative ones,
+//-0.0 is mapped to 0.0 first (NaN has no place in the order); integers: flip the sign bit
+inline WeightKey weightKey(Weight w) {
+    static_assert(sizeof(Weight) == 4 || sizeof(Weight) == 8, "weightKey needs a 32 or 64 bit Weight");
+    constexpr WeightKey SIGN = WeightKey {1} << (8 * sizeof(Weight) - 1);
+    if constexpr (std::is_floating_point_v<Weight>) {
+        if (w == 0) w = 0;
+        auto bits = std::bit_cast<WeightKey>(w);
+        return (bits & SIGN) ? ~bits : (bits | SIGN);
+    }
+    else {
+        return static_cast<WeightKey>(w) ^ SIGN;
+    }
+}
+
+//Kruskal with an LSD radix sort (8-bit digits) of the edges on the key (weightKey, edge ID),
+//which is the lighterEdge order: the forest is the same as every other engine's.
+//passes whose digit is equal for all edges are skipped, so small integer weights and IDs sort
+//in a few passes; numThreads > 1 runs each pass with per-thread histograms and a stable
+//parallel scatter on globalThreadPool() (<= 0: one part per pool thread). the union-find sweep stops after n - 1 edges
+//O(m (sizeof(Weight) + sizeof(Index))) for the sort, O(m a(n)) for the sweep
+SpanningForest radixKruskalForest(const Graph& G, int numThreads = 1);
+//same forest as a Graph
+Graph radixKruskalMST(const Graph& G, int numThreads = 1);
+
+#endif      // RADIX_KRUSKAL_HPP_
@@ -0,0 +1,168 @@
+#include "reorder.hpp"
+#include "graph.hpp"
+#include <array>
+#include <vector>
+#include <algorithm>
+#include <numeric>
+#include <cstdint>
+#include <functional>
+#include <stdexcept>
+
+namespace {
+
+Index degree(const Graph& G, Index v) {
+    return static_cast<Index>(G.neighbours(v)->size());
+}
+
+Index otherEnd(const Graph::Edge& e, Index v) {
+    return (e.v1 == v) ? e.v2 : e.v1;
+}
+
+//BFS from every unvisited vertex (starts taken in the given order), appends to order
+//neighbours are visited by increasing degree when byDegree is set (Cuthill-McKee)
+std::vector<Index> bfsOrder(const Graph& G, const std::vector<Index>& starts, bool byDegree) {
+    Index n = G.numVertices();
+    std::vector<Index> order;
+    order.reserve(n);
+    std::vector<bool> visited(n, false);
+    std::vector<Index> next;
+    for (Index s : starts) {
+        if (visited[s]) continue;
+        visited[s] = true;
+        std::size_t head = order.size();
+        order.push_back(s);
+        while (head < order.size()) {
+            Index u = order[head++];
+            next.clear();
+            for (const auto& e : *G.neighbours(u)) {
+                Index v = otherEnd(e, u);
+                if (visited[v]) continue;
+                visited[v] = true;
+                next.push_back(v);
+            }
+            if (byDegree) {
+                std::stable_sort(next.begin(), next.end(), [&G](Index a, Index b) {
+                    return degree(G, a) < degree(G, b);
+                });
+            }
+            order.insert(order.end(), next.begin(), next.end());
+        }
+    }
+    return order;
+}
+
+//position of (x, y) along a Hilbert curve filling a side x side grid (side a power of 2)
+std::uint64_t hilbertIndex(std::uint32_t side, std::uint32_t x, std::uint32_t y) {
+    std::uint64_t d = 0;
+    for (std::uint32_t s = side / 2; s > 0; s /= 2) {
+        std::uint32_t rx = (x & s) ? 1 : 0;
+        std::uint32_t ry = (y & s) ? 1 : 0;
+        d += static_cast<std::uint64_t>(s) * s * ((3 * rx) ^ ry);
+        //rotate the quadrant
+        if (ry == 0) {
+            if (rx == 1) {
+                x = side - 1 - x;
+                y = side - 1 - y;
+            }
+            std::swap(x, y);
+        }
+    }
+    return d;
+}
+
+ReorderedGraph relabel(const Graph& G, std::vector<Index> newToOld) {
+    Index n = G.numVertices();
+    ReorderedGraph R;
+    R.oldToNew.assign(n, -1);
+    for (Index v = 0; v < n; ++v) R.oldToNew[newToOld[v]] = v;
+    //edges grouped by their new first endpoint, orientation and ID unchanged
+    std::vector<Graph::Edge> edges;
+    for (Index v = 0; v < n; ++v) {
+        Index old = newToOld[v];
+        Index previousId = -1;
+        for (const auto& e : *G.neighbours(old)) {
+            if (old != e.v1) continue;                  //avoid duplicate edge
+            if (e.v1 == e.v2 && e.edgeId == previousId) continue;   //second copy of a self-loop
+            previousId = e.edgeId;
+            edges.push_back({e.weight, R.oldToNew[e.v1], R.oldToNew[e.v2], e.edgeId});
+        }
+    }
+    R.graph = Graph(n, std::move(edges));
+    R.newToOld = std::move(newToOld);
+    return R;
+}
+
+}  // namespace
+
+ReorderedGraph reorderGraph(const Graph& G, VertexOrder order) {
+    Index n = G.numVertices();
+    std::vector<Index> vertices(n);
+    std::iota(vertices.begin(), vertices.end(), 0);
+    switch (order) {
+        case VertexOrder::BFS:
+            return relabel(G, bfsOrder(G, vertices, false));
+        case VertexOrder::RCM: {
+            //start every component at a vertex of minimum degree, then reverse
+            std::stable_sort(vertices.begin(), vertices.end(), [&G](Index a, Index b) {
+                return degree(G, a) < degree(G, b);
+            });
+            std::vector<Index> cm = bfsOrder(G, vertices, true);
+            std::reverse(cm.begin(), cm.end());
+            return relabel(G, std::move(cm));
+        }
+        case VertexOrder::Degree:
+            std::stable_sort(vertices.begin(), vertices.end(), [&G](Index a, Index b) {
+                return degree(G, a) > degree(G, b);
+            });
+            return relabel(G, std::move(vertices));
+        case VertexOrder::Hilbert:
+        default:
+            throw std::invalid_argument("reorderGraph: the Hilbert order needs vertex coordinates");
+    }
+}
+
+ReorderedGraph reorderGraph(const Graph& G, const std::vector<std::array<double, 2>>& coords) {
+    Index n = G.numVertices();
+    std::vector<Index> vertices(n);
+    std::iota(vertices.begin(), vertices.end(), 0);
+    if (n == 0) return relabel(G, std::move(vertices));
+    //quantize the bounding box to a 2^16 x 2^16 grid
+    double minX = coords[0][0], maxX = coords[0][0];
+    double minY = coords[0][1], maxY = coords[0][1];
+    for (Index v = 0; v < n; ++v) {
+        minX = std::min(minX, coords[v][0]);
+        maxX = std::max(maxX, coords[v][0]);
+        minY = std::min(minY, coords[v][1]);
+        maxY = std::max(maxY, coords[v][1]);
+    }
+    const std::uint32_t side = 1u << 16;
+    double scaleX = (maxX > minX) ? (side - 1) / (maxX - minX) : 0.0;
+    double scaleY = (maxY > minY) ? (side - 1) / (maxY - minY) : 0.0;
+    std::vector<std::uint64_t> key(n);
+    for (Index v = 0; v < n; ++v) {
+        auto x = static_cast<std::uint32_t>((coords[v][0] - minX) * scaleX);
+        auto y = static_cast<std::uint32_t>((coords[v][1] - minY) * scaleY);
+        key[v] = hilbertIndex(side, x, y);
+    }
+    std::stable_sort(vertices.begin(), vertices.end(), [&key](Index a, Index b) {
+        return key[a] < key[b];
+    });
+    return relabel(G, std::move(vertices));
+}
+
+Graph restoreOriginalIds(const ReorderedGraph& R, const Graph& F) {
+    Index n = F.numVertices();
+    std::vector<Graph::Edge> edges;
+    for (Index u = 0; u < n; ++u) {
+        for (const auto& e : *F.neighbours(u)) {
+            if (u != e.v1) continue;
+            edges.push_back({e.weight, R.newToOld[e.v1], R.newToOld[e.v2], e.edgeId});
+        }
+    }
+    return Graph(n, std::move(edges));
+}
+
+Graph reorderedMST(const Graph& G, VertexOrder order, const std::function<Graph(const Graph&)>& engine) {
+    ReorderedGraph R = reorderGraph(G, order);
+    return restoreOriginalIds(R, engine(R.graph));
+}
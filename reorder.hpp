@@ -0,0 +1,37 @@
+#ifndef REORDER_HPP_
+#define REORDER_HPP_
+
+#include "graph.hpp"
+#include <array>
+#include <vector>
+#include <functional>
+
+//vertex orders for the cache-locality preprocessing pass
+enum class VertexOrder {
+    BFS,        //breadth-first order, component by component
+    RCM,        //reverse Cuthill-McKee (small bandwidth)
+    Degree,     //decreasing degree (hubs first)
+    Hilbert     //along a Hilbert curve through the vertex coordinates
+};
+
+//graph with relabelled vertices; edge IDs and edge orientation are kept
+struct ReorderedGraph {
+    Graph graph;                    //relabelled graph
+    std::vector<Index> newToOld;    //newToOld[v]: original ID of new vertex v
+    std::vector<Index> oldToNew;    //oldToNew[v]: new ID of original vertex v
+};
+
+//relabel G in the given order
+//Hilbert needs coordinates: it throws std::invalid_argument here, use the overload below
+ReorderedGraph reorderGraph(const Graph& G, VertexOrder order);
+//relabel G along a Hilbert curve through coords (coords[v]: position of vertex v)
+ReorderedGraph reorderGraph(const Graph& G, const std::vector<std::array<double, 2>>& coords);
+
+//translate a forest of R.graph (e.g. its MST) back to the original vertex IDs
+Graph restoreOriginalIds(const ReorderedGraph& R, const Graph& F);
+
+//reorder G, run engine on the relabelled graph and return its forest in original IDs
+//(any order but Hilbert)
+Graph reorderedMST(const Graph& G, VertexOrder order, const std::function<Graph(const Graph&)>& engine);
+
+#endif      // REORDER_HPP_
@@ -0,0 +1,285 @@
+#include "sensitivity.hpp"
+#include "clustering.hpp"
+#include "boruvka.hpp"
+#include "union_find.hpp"
+#include "graph.hpp"
+#include <vector>
+#include <queue>
+#include <algorithm>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+
+namespace {
+
+//every edge of G once (self-loops too), in adjacency order
+std::vector<Graph::Edge> edgeList(const Graph& G) {
+    std::vector<Graph::Edge> edges;
+    for (Index u = 0; u < G.numVertices(); ++u) {
+        Index previousId = -1;
+        for (const auto& e : *G.neighbours(u)) {
+            if (u != e.v1) continue;                                //avoid duplicate edge
+            if (e.v1 == e.v2 && e.edgeId == previousId) continue;   //second copy of a self-loop
+            previousId = e.edgeId;
+            edges.push_back(e);
+        }
+    }
+    return edges;
+}
+
+//lowest common ancestor in the Kruskal tree of every query pair (-1 if in different trees)
+//Tarjan's offline algorithm: post-order walk, finished subtrees are merged into their parent
+std::vector<Index> offlineLCA(const KruskalTree& krt, const std::vector<std::pair<Index, Index>>& queries) {
+    Index n = krt.numLeaves;
+    Index nodes = krt.numNodes();
+    //queries of every leaf, as (other leaf, query) in CSR layout
+    std::vector<Index> start(n + 1, 0);
+    for (const auto& [u, v] : queries) {
+        ++start[u + 1];
+        ++start[v + 1];
+    }
+    for (Index v = 0; v < n; ++v) start[v + 1] += start[v];
+    std::vector<std::pair<Index, Index>> list(start[n]);
+    std::vector<Index> fill(start.begin(), start.end() - 1);
+    for (Index q = 0; q < static_cast<Index>(queries.size()); ++q) {
+        auto [u, v] = queries[q];
+        list[fill[u]++] = {v, q};
+        list[fill[v]++] = {u, q};
+    }
+
+    std::vector<Index> lca(queries.size(), -1);
+    UnionFind UF(nodes);
+    std::vector<Index> ancestor(nodes);
+    std::vector<Index> treeRoot(nodes, -1);
+    std::vector<bool> finished(nodes, false);
+    std::vector<std::pair<Index, int>> stack;          //node, number of children visited
+    for (Index root = 0; root < nodes; ++root) {
+        if (krt.parent[root] != -1) continue;
+        treeRoot[root] = root;
+        ancestor[root] = root;
+        stack.push_back({root, 0});
+        while (!stack.empty()) {
+            auto& [x, visited] = stack.back();
+            Index child = (visited == 0) ? krt.left[x] : (visited == 1) ? krt.right[x] : -1;
+            if (visited < 2 && child != -1) {
+                ++visited;
+                treeRoot[child] = root;
+                ancestor[child] = child;
+                stack.push_back({child, 0});
+                continue;
+            }
+            //all children done
+            Index node = x;
+            stack.pop_back();
+            finished[node] = true;
+            if (node < n) {
+                for (Index i = start[node]; i < start[node + 1]; ++i) {
+                    auto [other, q] = list[i];
+                    if (finished[other] && treeRoot[other] == root) lca[q] = ancestor[UF.find(other)];
+                }
+            }
+            if (!stack.empty()) {
+                Index p = stack.back().first;
+                UF.merge(p, node);
+                ancestor[UF.find(p)] = p;
+            }
+        }
+    }
+    return lca;
+}
+
+//nearest ancestor-or-self whose parent edge is still uncovered (path compression)
+Index uncovered(std::vector<Index>& jump, Index v) {
+    Index root = v;
+    while (jump[root] != root) root = jump[root];
+    while (jump[v] != root) {
+        Index next = jump[v];
+        jump[v] = root;
+        v = next;
+    }
+    return root;
+}
+
+}  // namespace
+
+std::vector<EdgeSensitivity> sensitivityAnalysis(const Graph& G, const Graph& mst) {
+    Index n = G.numVertices();
+    std::vector<Graph::Edge> edges = edgeList(G);
+    std::vector<Graph::Edge> treeEdges = edgeList(mst);
+    std::unordered_set<Index> treeIds;
+    treeIds.reserve(treeEdges.size());
+    for (const auto& e : treeEdges) treeIds.insert(e.edgeId);
+
+    std::vector<EdgeSensitivity> result(edges.size());
+    std::vector<Index> nonTree;                         //positions in edges
+    std::vector<std::pair<Index, Index>> queries;
+    for (std::size_t i = 0; i < edges.size(); ++i) {
+        const auto& e = edges[i];
+        bool inTree = treeIds.count(e.edgeId) > 0;
+        result[i] = {e.edgeId, inTree, inTree ? WEIGHT_MAX : WEIGHT_MIN, -1};
+        if (inTree || e.v1 == e.v2) continue;
+        nonTree.push_back(static_cast<Index>(i));
+        queries.push_back({e.v1, e.v2});
+    }
+
+    //non-tree edges: the heaviest edge on the tree path made their LCA in the Kruskal tree
+    KruskalTree krt = buildKruskalTree(mst);
+    std::vector<Index> lca = offlineLCA(krt, queries);
+    for (std::size_t q = 0; q < nonTree.size(); ++q) {
+        auto& s = result[nonTree[q]];
+        if (lca[q] == -1) {                             //joins two trees: mst was not spanning
+            s.threshold = WEIGHT_MAX;
+            continue;
+        }
+        s.threshold = krt.height[lca[q]];
+        s.replacement = krt.edgeId[lca[q]];
+    }
+
+    //tree edges: root the forest, remember the edge above every vertex
+    std::vector<Index> parent(n, -1);
+    std::vector<Index> parentEdge(n, -1);               //edge ID of the edge to the parent
+    std::vector<Index> depth(n, -1);
+    std::vector<Index> tree(n, -1);
+    std::vector<std::vector<std::pair<Index, Index>>> adj(n);
+    for (const auto& e : treeEdges) {
+        adj[e.v1].push_back({e.v2, e.edgeId});
+        adj[e.v2].push_back({e.v1, e.edgeId});
+    }
+    std::vector<Index> queue;
+    for (Index root = 0; root < n; ++root) {
+        if (depth[root] != -1) continue;
+        depth[root] = 0;
+        tree[root] = root;
+        queue.assign(1, root);
+        for (std::size_t head = 0; head < queue.size(); ++head) {
+            Index x = queue[head];
+            for (auto [y, id] : adj[x]) {
+                if (depth[y] != -1) continue;
+                depth[y] = depth[x] + 1;
+                parent[y] = x;
+                parentEdge[y] = id;
+                tree[y] = root;
+                queue.push_back(y);
+            }
+        }
+    }
+    //lightest non-tree edges first: each covers the still uncovered tree edges on its path
+    std::vector<Weight> cover(n, WEIGHT_MAX);
+    std::vector<Index> coverEdge(n, -1);
+    std::sort(nonTree.begin(), nonTree.end(), [&edges](Index a, Index b) {
+        return lighterEdge(edges[a], edges[b]);
+    });
+    std::vector<Index> jump(n);
+    for (Index v = 0; v < n; ++v) jump[v] = v;
+    for (Index i : nonTree) {
+        const auto& e = edges[i];
+        if (tree[e.v1] != tree[e.v2]) continue;
+        Index a = uncovered(jump, e.v1);
+        Index b = uncovered(jump, e.v2);
+        while (a != b) {
+            if (depth[a] < depth[b]) std::swap(a, b);
+            cover[a] = e.weight;
+            coverEdge[a] = e.edgeId;
+            jump[a] = parent[a];
+            a = uncovered(jump, a);
+        }
+    }
+    std::unordered_map<Index, Index> position;          //position in result of every tree edge
+    position.reserve(treeEdges.size());
+    for (std::size_t i = 0; i < edges.size(); ++i) {
+        if (result[i].inTree) position[edges[i].edgeId] = static_cast<Index>(i);
+    }
+    for (Index v = 0; v < n; ++v) {
+        if (parentEdge[v] == -1) continue;
+        auto& s = result[position.at(parentEdge[v])];
+        s.threshold = cover[v];
+        s.replacement = coverEdge[v];
+    }
+
+    std::sort(result.begin(), result.end(), [](const EdgeSensitivity& a, const EdgeSensitivity& b) {
+        return a.edgeId < b.edgeId;
+    });
+    return result;
+}
+
+std::vector<EdgeSensitivity> sensitivityAnalysis(const Graph& G) {
+    return sensitivityAnalysis(G, boruvkaMST(G));
+}
+
+std::vector<Graph> kBestSpanningTrees(const Graph& G, int k) {
+    std::vector<Graph> result;
+    if (k <= 0) return result;
+    Index n = G.numVertices();
+    std::vector<Graph::Edge> edges;
+    for (const auto& e : edgeList(G)) {
+        if (e.v1 != e.v2) edges.push_back(e);           //self-loops are in no spanning forest
+    }
+    std::sort(edges.begin(), edges.end(), lighterEdge);
+    Index m = static_cast<Index>(edges.size());
+
+    //edges forced in and kept out (positions in edges), and the best forest under these rules
+    struct Subproblem {
+        WeightSum weight {0};
+        std::vector<Index> tree;
+        std::vector<Index> forced;
+        std::vector<Index> banned;
+    };
+    std::vector<char> rule(m, 0);                       //0: free, 1: forced, 2: banned
+    //Kruskal with the forced edges first
+    auto solve = [&](Subproblem& s) {
+        for (Index p : s.forced) rule[p] = 1;
+        for (Index p : s.banned) rule[p] = 2;
+        UnionFind UF(n);
+        s.tree.clear();
+        s.weight = 0;
+        for (Index p : s.forced) {
+            UF.merge(edges[p].v1, edges[p].v2);
+            s.tree.push_back(p);
+            s.weight += edges[p].weight;
+        }
+        for (Index p = 0; p < m; ++p) {
+            if (rule[p] != 0 || UF.sameSet(edges[p].v1, edges[p].v2)) continue;
+            UF.merge(edges[p].v1, edges[p].v2);
+            s.tree.push_back(p);
+            s.weight += edges[p].weight;
+        }
+        for (Index p : s.forced) rule[p] = 0;
+        for (Index p : s.banned) rule[p] = 0;
+        std::sort(s.tree.begin(), s.tree.end());
+    };
+
+    auto heavier = [](const Subproblem& a, const Subproblem& b) {
+        if (a.weight != b.weight) return a.weight > b.weight;
+        return a.tree > b.tree;
+    };
+    std::priority_queue<Subproblem, std::vector<Subproblem>, decltype(heavier)> heap(heavier);
+    Subproblem first;
+    solve(first);
+    std::size_t target = first.tree.size();             //a smaller forest is not spanning
+    heap.push(std::move(first));
+
+    while (!heap.empty() && static_cast<int>(result.size()) < k) {
+        Subproblem best = heap.top();
+        heap.pop();
+        std::vector<Graph::Edge> treeEdges;
+        for (Index p : best.tree) treeEdges.push_back(edges[p]);
+        result.push_back(Graph(n, std::move(treeEdges)));
+        //partition the remaining trees: child j keeps the first j free edges and drops edge j
+        std::vector<Index> freeEdges;
+        for (Index p : best.tree) {
+            if (std::find(best.forced.begin(), best.forced.end(), p) == best.forced.end()) {
+                freeEdges.push_back(p);
+            }
+        }
+        for (std::size_t j = 0; j < freeEdges.size(); ++j) {
+            Subproblem child;
+            child.forced = best.forced;
+            child.forced.insert(child.forced.end(), freeEdges.begin(), freeEdges.begin() + j);
+            child.banned = best.banned;
+            child.banned.push_back(freeEdges[j]);
+            solve(child);
+            if (child.tree.size() == target) heap.push(std::move(child));
+        }
+    }
+    return result;
+}
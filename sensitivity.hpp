@@ -0,0 +1,37 @@
+#ifndef SENSITIVITY_HPP_
+#define SENSITIVITY_HPP_
+
+#include "graph.hpp"
+#include <vector>
+
+//how far the weight of one edge can move before the minimum spanning forest changes
+struct EdgeSensitivity {
+    Index edgeId;
+    bool inTree;            //is the edge in the given forest?
+    //tree edge: it stays in the forest while its weight is below threshold, the weight of the
+    //           lightest non-tree edge across its cut (WEIGHT_MAX for a bridge)
+    //non-tree edge: it enters once its weight drops below threshold, the heaviest weight on
+    //           the tree path between its endpoints (WEIGHT_MIN for a self-loop)
+    //at exactly the threshold the edge IDs break the tie (see lighterEdge)
+    Weight threshold;
+    //edge swapped in or out at the threshold (-1 if none)
+    Index replacement;
+};
+
+//replacement thresholds of every edge of G (one entry per edge, sorted by edge ID)
+//mst must be a minimum spanning forest of G (e.g. from boruvkaMST or kktMST)
+//non-tree edges: offline path maxima, Tarjan's LCA on the Kruskal reconstruction tree
+//tree edges: non-tree edges in increasing order cover the uncovered tree edges on their path,
+//a union-find over the rooted forest skips edges that are already covered
+//O(m log m) for sorting, otherwise O(m a(n))
+std::vector<EdgeSensitivity> sensitivityAnalysis(const Graph& G, const Graph& mst);
+//same, computing the forest with boruvkaMST
+std::vector<EdgeSensitivity> sensitivityAnalysis(const Graph& G);
+
+//the k lightest spanning forests of G (every one with the edge count of the minimum spanning
+//forest), lightest first; fewer if G has fewer than k
+//Lawler's partitioning: each subproblem forces some edges in and some out and is solved by
+//Kruskal over one shared sorted edge list, O(k n m a(n)) overall
+std::vector<Graph> kBestSpanningTrees(const Graph& G, int k);
+
+#endif      // SENSITIVITY_HPP_
@@ -0,0 +1,31 @@
+#include "spanning_forest.hpp"
+#include "graph.hpp"
+#include <vector>
+#include <algorithm>
+
+SpanningForest::SpanningForest(Index n) : numVertices(n) {}
+
+void SpanningForest::add(const Graph::Edge& e) {
+    edges.push_back(e);
+    weight += e.weight;
+}
+
+Index SpanningForest::numComponents() const {
+    return numVertices - static_cast<Index>(edges.size());
+}
+
+std::vector<Index> SpanningForest::edgeIds() const {
+    std::vector<Index> ids;
+    ids.reserve(edges.size());
+    for (const auto& e : edges) ids.push_back(e.edgeId);
+    std::sort(ids.begin(), ids.end());
+    return ids;
+}
+
+Graph SpanningForest::toGraph() const {
+    return Graph(numVertices, edges);
+}
+
+std::size_t SpanningForest::memoryBytes() const {
+    return sizeof(SpanningForest) + edges.capacity() * sizeof(Graph::Edge);
+}
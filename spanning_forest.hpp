@@ -0,0 +1,30 @@
+#ifndef SPANNING_FOREST_HPP_
+#define SPANNING_FOREST_HPP_
+
+#include "graph.hpp"
+#include <vector>
+#include <cstddef>
+
+//Minimum spanning forest as one flat edge list, what the engines fill while they run
+//edges keep the IDs of the input graph; adjacency lists are only built by toGraph()
+struct SpanningForest {
+    Index numVertices {0};
+    std::vector<Graph::Edge> edges;     //forest edges, in the order they were chosen
+    WeightSum weight {0};               //total weight of the forest
+
+    SpanningForest() = default;
+    explicit SpanningForest(Index n);
+
+    //append a forest edge (the caller guarantees it closes no cycle)
+    void add(const Graph::Edge& e);
+    //number of trees, isolated vertices included
+    Index numComponents() const;
+    //IDs of the forest edges, sorted
+    std::vector<Index> edgeIds() const;
+    //the forest as a Graph on numVertices vertices, edges added in order
+    Graph toGraph() const;
+    //approximate footprint in bytes
+    std::size_t memoryBytes() const;
+};
+
+#endif      // SPANNING_FOREST_HPP_
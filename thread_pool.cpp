@@ -0,0 +1,141 @@
+#include "thread_pool.hpp"
+#include <cstdlib>
+
+namespace {
+
+//pool the calling thread works for, and its index there
+thread_local const ThreadPool* currentPool = nullptr;
+thread_local int currentIndex = 0;
+
+//failed steal attempts (with a yield each) before an idle worker goes to sleep
+constexpr int SPINS_BEFORE_SLEEP = 64;
+
+std::atomic<int> globalSize {0};
+std::atomic<bool> globalCreated {false};
+
+}  // namespace
+
+TaskGroup::~TaskGroup() {
+    waitForTasks();
+}
+
+void TaskGroup::waitForTasks() {
+    while (pending.load(std::memory_order_acquire) > 0) {
+        if (!pool.runOne()) std::this_thread::yield();
+    }
+}
+
+void TaskGroup::wait() {
+    waitForTasks();
+    std::exception_ptr first;
+    {
+        std::lock_guard<std::mutex> guard(errorLock);
+        std::swap(first, error);
+    }
+    if (first) std::rethrow_exception(first);
+}
+
+ThreadPool::ThreadPool(int numThreads) {
+    if (numThreads <= 0) numThreads = static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+    for (int t = 0; t < numThreads; ++t) queues.push_back(std::make_unique<Queue>());
+    for (int t = 1; t < numThreads; ++t) workers.emplace_back(&ThreadPool::work, this, t);
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> guard(sleepLock);
+        stopping = true;
+    }
+    wake.notify_all();
+    for (auto& worker : workers) worker.join();
+}
+
+int ThreadPool::threadIndex() const {
+    return currentPool == this ? currentIndex : 0;
+}
+
+void ThreadPool::push(PoolTask* task) {
+    Queue& own = *queues[threadIndex()];
+    {
+        std::lock_guard<std::mutex> guard(own.lock);
+        own.tasks.push_back(task);
+    }
+    queued.fetch_add(1);
+    //sleepers is raised before a worker checks queued, so either it sees the task or we see it
+    if (sleepers.load() > 0) {
+        std::lock_guard<std::mutex> guard(sleepLock);
+        wake.notify_one();
+    }
+}
+
+bool ThreadPool::runOne() {
+    if (queued.load() == 0) return false;
+    int self = threadIndex();
+    int count = numThreads();
+    PoolTask* task = nullptr;
+    for (int k = 0; k < count && !task; ++k) {
+        Queue& q = *queues[(self + k) % count];
+        std::lock_guard<std::mutex> guard(q.lock);
+        if (q.tasks.empty()) continue;
+        if (k == 0) {
+            task = q.tasks.back();                      //own deque: newest first
+            q.tasks.pop_back();
+        }
+        else {
+            task = q.tasks.front();                     //steal the oldest, usually the largest range
+            q.tasks.pop_front();
+        }
+    }
+    if (!task) return false;
+    queued.fetch_sub(1);
+    TaskGroup* group = task->group;
+    try {
+        task->run();
+    }
+    catch (...) {
+        std::lock_guard<std::mutex> guard(group->errorLock);
+        if (!group->error) group->error = std::current_exception();
+    }
+    delete task;
+    group->pending.fetch_sub(1, std::memory_order_release);     //the group may be gone after this
+    return true;
+}
+
+void ThreadPool::work(int index) {
+    currentPool = this;
+    currentIndex = index;
+    int idle = 0;
+    while (!stopping.load()) {
+        if (runOne()) {
+            idle = 0;
+            continue;
+        }
+        if (++idle < SPINS_BEFORE_SLEEP) {
+            std::this_thread::yield();
+            continue;
+        }
+        std::unique_lock<std::mutex> guard(sleepLock);
+        ++sleepers;
+        wake.wait(guard, [this] { return stopping.load() || queued.load() > 0; });
+        --sleepers;
+        idle = 0;
+    }
+}
+
+ThreadPool& globalThreadPool() {
+    static ThreadPool pool([] {
+        globalCreated = true;
+        int size = globalSize.load();
+        if (size <= 0) {
+            if (const char* env = std::getenv("MST_THREADS")) size = std::atoi(env);
+        }
+        return size;
+    }());
+    return pool;
+}
+
+bool setGlobalThreadPoolSize(int numThreads) {
+    if (globalCreated.load()) return false;
+    globalSize = numThreads;
+    return true;
+}
@@ -0,0 +1,218 @@
+#ifndef THREAD_POOL_HPP_
+#define THREAD_POOL_HPP_
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+class ThreadPool;
+class TaskGroup;
+
+//queued unit of work of a TaskGroup
+struct PoolTask {
+    TaskGroup* group {nullptr};
+
+    virtual ~PoolTask() = default;
+    virtual void run() = 0;
+};
+
+template <typename F>
+struct PoolTaskOf : PoolTask {
+    F f;
+
+    explicit PoolTaskOf(F fn) : f(std::move(fn)) {}
+    void run() override {
+        f();
+    }
+};
+
+//Fork-join: tasks started with run() may execute on any thread of the pool, wait() returns
+//once all of them (and the tasks they started in this group) have finished
+//a waiting thread runs queued tasks itself, so groups nest without blocking threads
+class TaskGroup {
+ public:
+    explicit TaskGroup(ThreadPool& pool) : pool(pool) {}
+    //waits for the remaining tasks, their exceptions are dropped
+    ~TaskGroup();
+    TaskGroup(const TaskGroup&) = delete;
+    TaskGroup& operator=(const TaskGroup&) = delete;
+
+    template <typename F>
+    void run(F&& f);
+    //wait for every task, then rethrow the first exception one of them threw
+    void wait();
+
+ private:
+    friend class ThreadPool;
+    ThreadPool& pool;
+    std::atomic<std::size_t> pending {0};
+    std::mutex errorLock;
+    std::exception_ptr error;
+
+    void waitForTasks();
+};
+
+//Work-stealing thread pool
+//numThreads threads take part in the work: numThreads - 1 workers plus the thread that waits
+//for a TaskGroup (or calls parallelFor / parallelReduce). every thread has its own deque; it
+//pushes and pops its newest tasks at the back, idle threads steal the oldest task from the
+//front of another deque, and sleep when there is nothing to steal. tasks started by threads
+//outside the pool share deque 0. after fork() the child has no workers: loops still complete,
+//on the calling thread
+class ThreadPool {
+ public:
+    //numThreads <= 0: one per hardware thread
+    explicit ThreadPool(int numThreads = 0);
+    //joins the workers; every TaskGroup must have finished
+    ~ThreadPool();
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    int numThreads() const {
+        return static_cast<int>(queues.size());
+    }
+    //index of the calling thread: 1 .. numThreads() - 1 on the workers, 0 on every other thread
+    int threadIndex() const;
+
+    //call f(lo, hi) on disjoint ranges of at most grain indices covering [begin, end)
+    //ranges are split in halves, one half is left for stealing; grain <= 0 picks about
+    //8 ranges per thread
+    template <typename I, typename F>
+    void parallelFor(I begin, I end, I grain, F&& f) {
+        if (end <= begin) return;
+        if (grain <= 0) grain = autoGrain(end - begin);
+        if (numThreads() == 1) {
+            for (I lo = begin; lo < end;) {
+                I hi = lo + std::min(grain, end - lo);
+                f(lo, hi);
+                lo = hi;
+            }
+            return;
+        }
+        TaskGroup group(*this);
+        splitFor(group, begin, end, grain, f);
+        group.wait();
+    }
+
+    //call f(part) for part = 0 .. numParts - 1, every part a task of its own
+    //(for work split into a fixed number of parts, each with its own state)
+    template <typename F>
+    void parallelParts(int numParts, F&& f) {
+        parallelFor(0, numParts, 1, [&f](int lo, int) { f(lo); });
+    }
+
+    //combine(map(lo1, hi1), map(lo2, hi2)) over ranges of at most grain indices of [begin, end),
+    //identity for an empty range. ranges are combined in a fixed binary tree that only depends on
+    //begin, end and grain: with an explicit grain the result is the same for every pool size
+    template <typename I, typename T, typename Map, typename Combine>
+    T parallelReduce(I begin, I end, I grain, T identity, Map&& map, Combine&& combine) {
+        if (end <= begin) return identity;
+        if (grain <= 0) grain = autoGrain(end - begin);
+        return reduceRange<T>(begin, end, grain, map, combine);
+    }
+
+ private:
+    friend class TaskGroup;
+
+    struct alignas(64) Queue {
+        std::mutex lock;
+        std::deque<PoolTask*> tasks;
+    };
+
+    std::vector<std::unique_ptr<Queue>> queues;     //queues[t]: deque of thread t
+    std::vector<std::thread> workers;
+    std::atomic<std::size_t> queued {0};            //tasks in all deques
+    std::atomic<int> sleepers {0};
+    std::atomic<bool> stopping {false};
+    std::mutex sleepLock;
+    std::condition_variable wake;
+
+    void push(PoolTask* task);
+    //run one queued task (own deque first, then stolen), false if there was none
+    bool runOne();
+    void work(int index);
+
+    template <typename I>
+    I autoGrain(I size) const {
+        return std::max<I>(1, size / static_cast<I>(8 * numThreads()));
+    }
+
+    template <typename I, typename F>
+    void splitFor(TaskGroup& group, I lo, I hi, I grain, F& f) {
+        while (hi - lo > grain) {
+            I mid = lo + (hi - lo) / 2;
+            group.run([this, &group, mid, hi, grain, &f] { splitFor(group, mid, hi, grain, f); });
+            hi = mid;
+        }
+        f(lo, hi);
+    }
+
+    template <typename T, typename I, typename Map, typename Combine>
+    T reduceRange(I lo, I hi, I grain, Map& map, Combine& combine) {
+        if (hi - lo <= grain) return map(lo, hi);
+        I mid = lo + (hi - lo) / 2;
+        if (numThreads() == 1) {
+            T left = reduceRange<T>(lo, mid, grain, map, combine);
+            return combine(std::move(left), reduceRange<T>(mid, hi, grain, map, combine));
+        }
+        std::optional<T> right;
+        TaskGroup group(*this);
+        group.run([&] { right.emplace(reduceRange<T>(mid, hi, grain, map, combine)); });
+        T left = reduceRange<T>(lo, mid, grain, map, combine);
+        group.wait();
+        return combine(std::move(left), std::move(*right));
+    }
+};
+
+template <typename F>
+void TaskGroup::run(F&& f) {
+    auto* task = new PoolTaskOf<std::decay_t<F>>(std::forward<F>(f));
+    task->group = this;
+    pending.fetch_add(1, std::memory_order_relaxed);
+    pool.push(task);
+}
+
+//One T per thread of a pool (on its own cache line), e.g. scratch buffers or partial results
+//local() is the slot of the calling thread; threads outside the pool share slot 0, so only
+//one of them at a time may use it
+template <typename T>
+class PerThread {
+ public:
+    explicit PerThread(const ThreadPool& pool, const T& initial = T())
+        : pool(pool), slots(pool.numThreads(), Slot {initial}) {}
+
+    T& local() {
+        return slots[pool.threadIndex()].value;
+    }
+    //call f(value) for every slot, in thread order
+    template <typename F>
+    void forEach(F&& f) {
+        for (auto& slot : slots) f(slot.value);
+    }
+
+ private:
+    struct alignas(64) Slot {
+        T value;
+    };
+    const ThreadPool& pool;
+    std::vector<Slot> slots;
+};
+
+//Pool shared by the whole library, created on first use with the size set by
+//setGlobalThreadPoolSize, else the MST_THREADS environment variable, else one thread per
+//hardware thread
+ThreadPool& globalThreadPool();
+//size of the global pool, false once it exists (it is sized once per process)
+bool setGlobalThreadPoolSize(int numThreads);
+
+#endif      // THREAD_POOL_HPP_
@@ -0,0 +1,34 @@
+#ifndef TYPES_HPP_
+#define TYPES_HPP_
+
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+
+//Weight and index types used by the whole library, chosen at compile time
+//(CMake: -DMST_WEIGHT_TYPE=float|double|std::int32_t|std::int64_t, -DMST_INDEX_64=ON)
+//float weights with 32-bit ids give 16-byte edges, 64-bit ids allow graphs beyond 2^31 edges
+#ifndef MST_WEIGHT_TYPE
+#define MST_WEIGHT_TYPE double
+#endif
+
+using Weight = MST_WEIGHT_TYPE;
+
+#ifdef MST_INDEX_64
+using Index = std::int64_t;
+#else
+using Index = std::int32_t;
+#endif
+
+static_assert(std::is_arithmetic_v<Weight>, "MST_WEIGHT_TYPE must be an arithmetic type");
+
+//type used to add up weights (no float round-off / int32 overflow on large forests)
+using WeightSum = std::conditional_t<std::is_floating_point_v<Weight>, double, std::int64_t>;
+
+//largest / smallest weight, infinities for floating point weights
+constexpr Weight WEIGHT_MAX = std::numeric_limits<Weight>::has_infinity ?
+                              std::numeric_limits<Weight>::infinity() : std::numeric_limits<Weight>::max();
+constexpr Weight WEIGHT_MIN = std::numeric_limits<Weight>::has_infinity ?
+                              -std::numeric_limits<Weight>::infinity() : std::numeric_limits<Weight>::lowest();
+
+#endif      // TYPES_HPP_
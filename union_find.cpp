@@ -3,23 +3,31 @@
 #include <numeric>
 #include "union_find.hpp"
 
-UnionFind::UnionFind(int N) : parent(N),
+UnionFind::UnionFind(Index N) : parent(N),
                               sizes(N, 1),
                               ranks(N,0),
                               componentsCount(N) {
     std::iota(parent.begin(), parent.end(), 0);
 }
 
+void UnionFind::reset(Index N) {
+    parent.resize(N);
+    std::iota(parent.begin(), parent.end(), 0);
+    sizes.assign(N, 1);
+    ranks.assign(N, 0);
+    componentsCount = N;
+}
+
 //union find with union by rank and path compression
-int UnionFind::find(int element) {
+Index UnionFind::find(Index element) {
     //Find the root of the current set
-    int root = element;
+    Index root = element;
     while (parent[root] != root) {
         root = parent[root]; 
     }
     //Path compression
     while (parent[element] != element) {
-        int next = parent[element];
+        Index next = parent[element];
         parent[element] = root;
         element = next;
     }
@@ -27,31 +35,43 @@ int UnionFind::find(int element) {
 }
 
 
-void UnionFind::merge(int element1, int element2) {
-    int root1 = find(element1);
-    int root2 = find(element2);
+void UnionFind::merge(Index element1, Index element2) {
+    Index root1 = find(element1);
+    Index root2 = find(element2);
     if (root1 == root2) {
         return;
     }
     if (ranks[root1] < ranks[root2]) {
         parent[root1] = root2;
+        sizes[root2] += sizes[root1];
 
     } else if (ranks[root1] > ranks[root2]) {
         parent[root2] = root1;
+        sizes[root1] += sizes[root2];
 
     } 
     // Ranks are equal
     else { 
         parent[root2] = root1; 
+        sizes[root1] += sizes[root2];
         ranks[root1]++;       
     }
     --componentsCount;
 }
 
-bool UnionFind::sameSet(int element1, int element2) {
+Index UnionFind::size(Index element) {
+    return sizes[find(element)];
+}
+
+bool UnionFind::sameSet(Index element1, Index element2) {
   return find(element1) == find(element2);
 }
 
-int UnionFind::numberOfComponents() const {
+Index UnionFind::numberOfComponents() const {
     return componentsCount;
+}
+
+std::size_t UnionFind::memoryBytes() const {
+    return sizeof(UnionFind) + parent.capacity() * sizeof(Index) +
+           sizes.capacity() * sizeof(Index) + ranks.capacity() * sizeof(int);
 }
\ No newline at end of file
@@ -2,28 +2,39 @@
 #define UNION_FIND_HPP_ 
 
 #include <vector>
+#include <cstddef>
+#include "types.hpp"
 
 //union find data structure using path compression
 class UnionFind {
     private:
-     std::vector<int> parent;
-     std::vector<int> sizes;
+     std::vector<Index> parent;
+     std::vector<Index> sizes;
      std::vector<int> ranks; 
-     int componentsCount;
+     Index componentsCount;
     public:
-     explicit UnionFind(int N);
+     explicit UnionFind(Index N);
+
+     // start over with N singleton sets, keeping the allocated storage
+     void reset(Index N);
 
      // return the name of the root of the tree containing element (with path compression)
-     int find(int element);
+     Index find(Index element);
 
      // merge the sets containing element1 and element2 (union by rank)
-     void merge(int element1, int element2);
+     void merge(Index element1, Index element2);
      
+     // number of elements in the set containing element
+     Index size(Index element);
+
      // are element1 and element2 in the same set?
-     bool sameSet(int element1, int element2);
+     bool sameSet(Index element1, Index element2);
 
      // return the number of components
-     int numberOfComponents() const; 
+     Index numberOfComponents() const; 
+
+     // approximate footprint in bytes
+     std::size_t memoryBytes() const;
 };
 
 #endif      // UNION_FIND_HPP_ 
\ No newline at end of file